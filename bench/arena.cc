@@ -0,0 +1,73 @@
+// Measures per-request scratch vectors: a handful of vectors are built, grown and thrown away,
+// either on the heap, in a std::pmr::monotonic_buffer_resource, or in an arena.
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/arena.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t requests = 10'000;
+constexpr std::size_t vectors_per_request = 8;
+constexpr std::size_t elements_per_vector = 200;
+
+alignas(std::max_align_t) std::byte buffer[1 << 20];
+
+template<typename Vector, typename... Args>
+void
+one_request(Args... args)
+{
+  for (std::size_t i = 0; i < vectors_per_request; ++i) {
+    Vector v(args...);
+    for (std::size_t j = 0; j < elements_per_vector; ++j) {
+      v.push_back(int(j));
+    }
+    bench::do_not_optimize(v.data());
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+
+  bench::report("std::vector<int>", bench::median_ns([] {
+    for (std::size_t r = 0; r < requests; ++r) {
+      one_request<std::vector<int>>();
+    }
+  }));
+  bench::report("cec::vector<int>", bench::median_ns([] {
+    for (std::size_t r = 0; r < requests; ++r) {
+      one_request<cec::vector<int>>();
+    }
+  }));
+  bench::report("std::pmr::vector<int>, monotonic_buffer_resource", bench::median_ns([] {
+    for (std::size_t r = 0; r < requests; ++r) {
+      std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+      one_request<std::pmr::vector<int>>(&resource);
+    }
+  }));
+  bench::report("cec::pmr::vector<int>, monotonic_buffer_resource", bench::median_ns([] {
+    for (std::size_t r = 0; r < requests; ++r) {
+      std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+      one_request<cec::pmr::vector<int>>(&resource);
+    }
+  }));
+  bench::report("cec::vector<int, arena_allocator<int>>", bench::median_ns([] {
+    cec::arena scratch(buffer);
+    auto alloc = cec::arena_allocator<int>(scratch);
+    for (std::size_t r = 0; r < requests; ++r) {
+      one_request<cec::vector<int, cec::arena_allocator<int>>>(alloc);
+      scratch.release();
+    }
+  }));
+}
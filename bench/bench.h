@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Tiny self-contained benchmark harness, so benchmarks don't need any external dependencies.
+//
+// Synopsis:
+//
+// do_not_optimize(value)
+//   Forces value to be materialized, so the computation producing it can't be optimized away
+// clobber_memory()
+//   Forces all pending writes to memory to happen
+// median_ns(fn, repetitions)
+//   Runs fn repetitions times after one warm-up run,
+//   returning the median wall time of a single run in nanoseconds
+// median_ns(setup, fn, repetitions)
+//   Like the above, but runs setup before every run of fn without timing it
+// report(name, ns)
+//   Prints a single result line, and remembers it for write_json
+// write_json(argc, argv)
+//   If the benchmark was run with --json=<file>, writes every reported result to file,
+//   along with the compiler and standard library, so results can be compared across runs
+// keep_heap_mapped()
+//   Stops glibc from returning freed memory to the kernel, otherwise every large reallocation
+//   pays for fresh page faults and results measure the kernel more than the container
+
+namespace bench {
+
+template<typename T>
+inline void
+do_not_optimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void
+clobber_memory()
+{
+  asm volatile("" : : : "memory");
+}
+
+template<typename Setup, typename Fn>
+double
+median_ns(Setup&& setup, Fn&& fn, int repetitions = 15)
+{
+  using clock = std::chrono::steady_clock;
+  std::vector<double> samples;
+  samples.reserve(repetitions);
+  setup();
+  fn();
+  for (int i = 0; i < repetitions; ++i) {
+    setup();
+    clobber_memory();
+    auto start = clock::now();
+    fn();
+    clobber_memory();
+    auto stop = clock::now();
+    samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+  return samples[samples.size() / 2];
+}
+
+template<typename Fn>
+double
+median_ns(Fn&& fn, int repetitions = 15)
+{
+  return median_ns([] {}, fn, repetitions);
+}
+
+struct result
+{
+  std::string name;
+  double ns;
+};
+
+inline std::vector<result>&
+results()
+{
+  static std::vector<result> rs;
+  return rs;
+}
+
+inline void
+report(const char* name, double ns)
+{
+  std::printf("%-60s %14.0f ns\n", name, ns);
+  results().push_back({ name, ns });
+}
+
+inline const char*
+standard_library()
+{
+#if defined(_LIBCPP_VERSION)
+  return "libc++";
+#elif defined(__GLIBCXX__)
+  return "libstdc++";
+#elif defined(_MSVC_STL_VERSION)
+  return "msvc";
+#else
+  return "unknown";
+#endif
+}
+
+// Names are only ever plain ASCII, so only quotes and backslashes need escaping
+inline void
+write_json_string(std::FILE* f, const std::string& str)
+{
+  std::fputc('"', f);
+  for (char c : str) {
+    if (c == '"' or c == '\\') {
+      std::fputc('\\', f);
+    }
+    std::fputc(c, f);
+  }
+  std::fputc('"', f);
+}
+
+inline int
+write_json(int argc, char** argv)
+{
+  const char* path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--json=", 7) == 0) {
+      path = argv[i] + 7;
+    }
+  }
+  if (path == nullptr) {
+    return 0;
+  }
+  std::FILE* f = std::fopen(path, "w");
+  if (f == nullptr) {
+    std::perror(path);
+    return 1;
+  }
+  std::fprintf(f, "{\n  \"context\": {\n    \"executable\": ");
+  write_json_string(f, argv[0]);
+  std::fprintf(f, ",\n    \"compiler\": ");
+  write_json_string(f, __VERSION__);
+  std::fprintf(f, ",\n    \"standard_library\": ");
+  write_json_string(f, standard_library());
+  std::fprintf(f, "\n  },\n  \"results\": [");
+  for (std::size_t i = 0; i < results().size(); ++i) {
+    std::fprintf(f, "%s\n    { \"name\": ", i == 0 ? "" : ",");
+    write_json_string(f, results()[i].name);
+    std::fprintf(f, ", \"ns\": %.1f }", results()[i].ns);
+  }
+  std::fprintf(f, "\n  ]\n}\n");
+  return std::fclose(f) == 0 ? 0 : 1;
+}
+
+inline void
+keep_heap_mapped()
+{
+#if defined(__GLIBC__)
+  mallopt(M_MMAP_THRESHOLD, 1 << 30);
+  mallopt(M_TRIM_THRESHOLD, 1 << 30);
+#endif
+}
+
+} // namespace bench
@@ -0,0 +1,56 @@
+// Measures clearing and refilling a large vector of small structs,
+// where clear() should cost nothing for trivially destructible types.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+struct point
+{
+  float x, y, z;
+};
+
+template<typename Vector>
+void
+run(const char* name, std::size_t n)
+{
+  Vector v(n);
+
+  std::printf("%s\n", name);
+  bench::report("  clear", bench::median_ns([&] { v.resize(n); }, [&] {
+    v.clear();
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("  clear + refill", bench::median_ns([&] {
+    v.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(typename Vector::value_type{});
+    }
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("  erase front half", bench::median_ns([&] { v.resize(n); }, [&] {
+    v.erase(v.begin(), v.begin() + n / 2);
+    bench::do_not_optimize(v.data());
+  }));
+}
+
+} // namespace
+
+int
+main()
+{
+  constexpr std::size_t n = 1 << 20;
+  bench::keep_heap_mapped();
+
+  run<cec::vector<point>>("cec::vector<point>", n);
+  run<std::vector<point>>("std::vector<point>", n);
+  run<cec::vector<std::string>>("cec::vector<std::string>", n);
+  run<std::vector<std::string>>("std::vector<std::string>", n);
+}
@@ -0,0 +1,46 @@
+// Measures == and <=> between large vectors which only differ in their last element,
+// for element types which are compared with memcmp or the SIMD mismatch kernel.
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/simd.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+template<typename Vector>
+void
+run(const char* name, std::size_t n)
+{
+  using T = typename Vector::value_type;
+  Vector a(n, T(1));
+  Vector b(n, T(1));
+  b.back() = T(2);
+
+  std::printf("%s\n", name);
+  bench::report("  ==", bench::median_ns([&] { bench::do_not_optimize(a == b); }));
+  bench::report("  <=>", bench::median_ns([&] { bench::do_not_optimize(a <=> b); }));
+}
+
+} // namespace
+
+int
+main()
+{
+  constexpr std::size_t bytes = 1 << 24;
+  bench::keep_heap_mapped();
+  std::printf("AVX2: %s\n", cec::simd::has_avx2() ? "yes" : "no");
+
+  run<std::vector<unsigned char>>("std::vector<unsigned char>", bytes);
+  run<cec::vector<unsigned char>>("cec::vector<unsigned char>", bytes);
+  run<std::vector<std::int32_t>>("std::vector<int32_t>", bytes / 4);
+  run<cec::vector<std::int32_t>>("cec::vector<int32_t>", bytes / 4);
+  run<std::vector<std::uint64_t>>("std::vector<uint64_t>", bytes / 8);
+  run<cec::vector<std::uint64_t>>("cec::vector<uint64_t>", bytes / 8);
+}
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""Compile-time benchmarks: how expensive vector_base is to use inside constant expressions.
+
+For every operation below, generates a translation unit which performs it N times inside a
+static_assert, and compiles it with -fsyntax-only at growing N. For each compiler it records
+compile time and peak compiler memory, and finds the largest N which still fits under the
+compiler's default constexpr limits (-fconstexpr-ops-limit / -fconstexpr-loop-limit for GCC,
+-fconstexpr-steps for Clang). Each search stops at --max-n, at the first limit error (which is
+then narrowed down by bisection), or when a compile takes longer than --timeout.
+
+Compilers which aren't installed are skipped. Run with --json=<file> to also write the results.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+PRELUDE = """\
+#include "constexpr_containers/vector.h"
+namespace cec = constexpr_containers;
+constexpr int N = BENCH_N;
+"""
+
+# Each operation is the body of a constexpr function returning a bool, N is defined on the command
+# line. The result is checked, so that the compiler can't skip any work.
+OPERATIONS = {
+    "push_back": """
+  cec::vector<int> v;
+  for (int i = 0; i < N; ++i) {
+    v.push_back(i);
+  }
+  return v[N - 1] == N - 1;
+""",
+    "reserve + push_back": """
+  cec::vector<int> v;
+  v.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    v.push_back(i);
+  }
+  return v[N - 1] == N - 1;
+""",
+    "insert at front": """
+  cec::vector<int> v;
+  for (int i = 0; i < N; ++i) {
+    v.insert(v.begin(), i);
+  }
+  return v[0] == N - 1;
+""",
+    "erase at front": """
+  cec::vector<int> v(N);
+  while (not v.empty()) {
+    v.erase(v.begin());
+  }
+  return v.empty();
+""",
+    "copy": """
+  cec::vector<int> v(N, 1);
+  cec::vector<int> w(v);
+  return w[N - 1] == 1;
+""",
+    "resize": """
+  cec::vector<int> v;
+  v.resize(N);
+  return v[N - 1] == 0;
+""",
+    "append_range": """
+  cec::vector<int> v(N, 1);
+  cec::vector<int> w;
+  w.append_range(v);
+  return w.size() == N;
+""",
+}
+
+COMPILERS = {
+    "g++": ["-std=c++20"],
+    "clang++": ["-std=c++20"],
+}
+
+
+def source(operation):
+    body = OPERATIONS[operation]
+    return PRELUDE + "constexpr bool run()\n{" + body + "}\nstatic_assert(run());\n"
+
+
+def compile_once(compiler, flags, path, n, timeout):
+    """Returns (ok, seconds, peak KiB), ok is None if the compiler timed out"""
+    include = os.path.join(ROOT, "include")
+    cmd = [compiler, *flags, "-fsyntax-only", "-I", include, f"-DBENCH_N={n}", path]
+    start = time.monotonic()
+    proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    deadline = start + timeout
+    while True:
+        pid, status, usage = os.wait4(proc.pid, os.WNOHANG)
+        if pid != 0:
+            break
+        if time.monotonic() > deadline:
+            proc.kill()
+            os.wait4(proc.pid, 0)
+            return None, timeout, 0
+        time.sleep(0.01)
+    seconds = time.monotonic() - start
+    return os.waitstatus_to_exitcode(status) == 0, seconds, usage.ru_maxrss
+
+
+def bench_operation(compiler, flags, operation, args, tmpdir):
+    path = os.path.join(tmpdir, "bench.cc")
+    with open(path, "w") as f:
+        f.write(source(operation))
+
+    # Make sure the operation compiles at all, so that errors aren't mistaken for hitting a limit
+    ok, _, _ = compile_once(compiler, flags, path, 1, args.timeout)
+    if not ok:
+        return {"operation": operation, "samples": [], "largest_n": 0, "stopped_by": "error"}
+
+    samples = []
+
+    def sample(n):
+        ok, seconds, kib = compile_once(compiler, flags, path, n, args.timeout)
+        samples.append({"n": n, "ok": ok, "seconds": round(seconds, 3), "peak_kib": kib})
+        return ok
+
+    largest_ok = 0
+    smallest_failed = None
+    stop = "max_n"
+    n = args.min_n
+    while n <= args.max_n:
+        ok = sample(n)
+        if ok is None:
+            stop = "timeout"
+            break
+        if not ok:
+            stop = "limit"
+            smallest_failed = n
+            break
+        largest_ok = n
+        n *= 2
+
+    # Narrow down the limit, if we hit one
+    while smallest_failed is not None and smallest_failed - largest_ok > max(largest_ok // 16, 1):
+        n = (largest_ok + smallest_failed) // 2
+        ok = sample(n)
+        if ok:
+            largest_ok = n
+        elif ok is None:
+            break
+        else:
+            smallest_failed = n
+
+    return {
+        "operation": operation,
+        "samples": sorted(samples, key=lambda s: s["n"]),
+        "largest_n": largest_ok,
+        "stopped_by": stop,
+    }
+
+
+def summary(result):
+    line = f"  {result['operation']:24} largest N {result['largest_n']:>8} ({result['stopped_by']})"
+    for s in result["samples"]:
+        if s["n"] == result["largest_n"]:
+            line += f", {s['seconds']:.2f} s and {s['peak_kib']} KiB there"
+    return line
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--json", help="also write the results to this file")
+    parser.add_argument("--min-n", type=int, default=1024)
+    parser.add_argument("--max-n", type=int, default=1 << 20)
+    parser.add_argument("--timeout", type=float, default=60, help="seconds per compile")
+    parser.add_argument("--operation", action="append", choices=OPERATIONS.keys(),
+                        help="only run these operations (default: all)")
+    args = parser.parse_args()
+
+    results = []
+    with tempfile.TemporaryDirectory() as tmpdir:
+        for compiler, flags in COMPILERS.items():
+            if shutil.which(compiler) is None:
+                print(f"{compiler}: not found, skipping")
+                continue
+            version = subprocess.run([compiler, "--version"], capture_output=True, text=True)
+            print(version.stdout.splitlines()[0])
+            for operation in args.operation or OPERATIONS.keys():
+                result = bench_operation(compiler, flags, operation, args, tmpdir)
+                result["compiler"] = compiler
+                result["version"] = version.stdout.splitlines()[0]
+                results.append(result)
+                print(summary(result))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+            f.write("\n")
+
+
+if __name__ == "__main__":
+    sys.exit(main())
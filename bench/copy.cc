@@ -0,0 +1,50 @@
+// Measures copy construction and copy assignment of large buffers of trivially copyable types,
+// which should run at close to memory bandwidth.
+
+#include <cstddef>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+struct pod
+{
+  double data[3];
+};
+
+template<typename Vector>
+void
+run(const char* name, std::size_t n)
+{
+  Vector src(n);
+  Vector dst;
+  dst.reserve(n);
+
+  std::printf("%s\n", name);
+  bench::report("  copy construct", bench::median_ns([&] {
+    Vector copy(src);
+    bench::do_not_optimize(copy.data());
+  }));
+  bench::report("  copy assign (no realloc)", bench::median_ns([&] {
+    dst = src;
+    bench::do_not_optimize(dst.data());
+  }));
+}
+
+} // namespace
+
+int
+main()
+{
+  constexpr std::size_t n = 1 << 22;
+  bench::keep_heap_mapped();
+
+  run<cec::vector<int>>("cec::vector<int>", n);
+  run<std::vector<int>>("std::vector<int>", n);
+  run<cec::vector<pod>>("cec::vector<pod>", n);
+  run<std::vector<pod>>("std::vector<pod>", n);
+}
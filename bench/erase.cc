@@ -0,0 +1,134 @@
+// Measures erasing a fraction of a large vector's elements: the ordered erase_if,
+// and unordered_erase_if, which fills the gaps from the back instead of shifting everything down.
+// Then erase(v, value) on integers and floats, which vectorizes.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/simd.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+// A move only handle, opted into relocation with memcpy below
+struct handle
+{
+  std::unique_ptr<int> p;
+};
+
+} // namespace
+
+template<>
+struct constexpr_containers::is_trivially_relocatable<handle> : std::true_type
+{};
+
+namespace {
+
+int
+key(int x)
+{
+  return x;
+}
+
+int
+key(const handle& h)
+{
+  return *h.p;
+}
+
+// Spreads the erased elements evenly, with a multiplicative hash
+bool
+pick(std::size_t i, int percent)
+{
+  return unsigned(i) * 2654435761u % 100 < unsigned(percent);
+}
+
+template<typename T>
+T
+make(int i)
+{
+  if constexpr (std::is_same_v<T, handle>) {
+    return handle{ std::make_unique<int>(i) };
+  } else {
+    return T(i);
+  }
+}
+
+template<typename Vector>
+void
+run(const char* name, std::size_t n)
+{
+  using T = typename Vector::value_type;
+  Vector v;
+
+  auto refill = [&] {
+    v.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(make<T>(int(i)));
+    }
+  };
+
+  std::printf("%s\n", name);
+  for (int percent : { 1, 50 }) {
+    // Spreads the erased elements evenly, with a multiplicative hash
+    auto pred = [=](const T& x) { return pick(std::size_t(key(x)), percent); };
+    std::printf("  %d%% erased\n", percent);
+    bench::report("    erase_if", bench::median_ns(refill, [&] {
+      bench::do_not_optimize(erase_if(v, pred));
+    }));
+    if constexpr (requires { v.unordered_erase_if(pred); }) {
+      bench::report("    unordered_erase_if", bench::median_ns(refill, [&] {
+        bench::do_not_optimize(v.unordered_erase_if(pred));
+      }));
+    }
+  }
+}
+
+template<typename Vector>
+void
+run_value(const char* name, std::size_t n)
+{
+  using T = typename Vector::value_type;
+  Vector v;
+
+  std::printf("%s\n", name);
+  for (int percent : { 1, 50 }) {
+    auto refill = [&] {
+      v.clear();
+      for (std::size_t i = 0; i < n; ++i) {
+        v.push_back(pick(i, percent) ? T(0) : T(i + 1));
+      }
+    };
+    bench::report(("  erase(v, 0), " + std::to_string(percent) + "% erased").c_str(),
+                  bench::median_ns(refill, [&] { bench::do_not_optimize(erase(v, T(0))); }));
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  constexpr std::size_t n = 1 << 20;
+  bench::keep_heap_mapped();
+
+  run<std::vector<int>>("std::vector<int>", n);
+  run<cec::vector<int>>("cec::vector<int>", n);
+  run<std::vector<handle>>("std::vector<handle>", n);
+  run<cec::vector<handle>>("cec::vector<handle>", n);
+
+  std::printf("AVX2: %s\n", cec::simd::has_avx2() ? "yes" : "no");
+  run_value<std::vector<std::uint32_t>>("std::vector<uint32_t>", n);
+  run_value<cec::vector<std::uint32_t>>("cec::vector<uint32_t>", n);
+  run_value<std::vector<std::uint64_t>>("std::vector<uint64_t>", n);
+  run_value<cec::vector<std::uint64_t>>("cec::vector<uint64_t>", n);
+  run_value<std::vector<float>>("std::vector<float>", n);
+  run_value<cec::vector<float>>("cec::vector<float>", n);
+}
@@ -0,0 +1,80 @@
+// Measures lower_bound over a sorted vector of 32-bit keys with std::lower_bound, against
+// eytzinger_index and btree_index built from it, for vectors from a quarter of the L1 cache to
+// several times a (typical) last level cache.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/eytzinger.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t lookups = 1 << 16;
+
+template<typename Search>
+void
+measure(const char* name, std::size_t n, const std::vector<std::uint32_t>& queries, Search search)
+{
+  auto ns = bench::median_ns([&] {
+    auto sum = std::size_t(0);
+    for (auto query : queries) {
+      sum += search(query);
+    }
+    bench::do_not_optimize(sum);
+  });
+  bench::report(("  " + std::string(name) + ", n = " + std::to_string(n)).c_str(), ns);
+}
+
+void
+run(std::size_t n)
+{
+  // Sorted keys with random gaps, so that queries land anywhere between them
+  auto rng = std::mt19937_64(n);
+  auto sorted = std::vector<std::uint32_t>(n);
+  auto key = std::uint32_t(0);
+  auto gap = std::uint32_t(std::max(std::size_t(2), (std::size_t(1) << 32) / n));
+  for (auto& elem : sorted) {
+    key += 1 + std::uint32_t(rng() % (gap - 1));
+    elem = key;
+  }
+  auto queries = std::vector<std::uint32_t>(lookups);
+  for (auto& query : queries) {
+    query = std::uint32_t(rng() % (std::uint64_t(key) + 1));
+  }
+
+  std::printf("%zu elements (%zu KiB), %zu lookups\n", n, n * 4 / 1024, lookups);
+  measure("std::lower_bound", n, queries, [&](std::uint32_t query) {
+    return std::size_t(std::lower_bound(sorted.begin(), sorted.end(), query) - sorted.begin());
+  });
+  {
+    auto index = cec::eytzinger_index<std::uint32_t>(sorted);
+    measure("eytzinger_index::lower_bound", n, queries, [&](std::uint32_t query) {
+      return index.lower_bound(query);
+    });
+  }
+  {
+    auto index = cec::btree_index<std::uint32_t>(sorted);
+    measure("btree_index::lower_bound", n, queries, [&](std::uint32_t query) {
+      return index.lower_bound(query);
+    });
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+  for (std::size_t n : { 1 << 12, 1 << 16, 1 << 19, 1 << 22, 1 << 25, 1 << 27 }) {
+    run(n);
+  }
+}
@@ -0,0 +1,81 @@
+// Measures looking up random keys in a flat_map, against std::map and a binary search with
+// std::lower_bound over the same keys, for maps from a few cache lines to well past the L2 cache.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/flat_map.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t lookups = 1 << 16;
+
+void
+run(std::size_t n)
+{
+  auto rng = std::mt19937_64(n);
+  auto keys = std::vector<std::uint64_t>(n);
+  for (auto& key : keys) {
+    key = rng();
+  }
+
+  auto elements = std::vector<std::pair<std::uint64_t, std::uint64_t>>();
+  for (auto key : keys) {
+    elements.emplace_back(key, key / 2);
+  }
+  auto flat = cec::flat_map<std::uint64_t, std::uint64_t>(elements.begin(), elements.end());
+  auto tree = std::map<std::uint64_t, std::uint64_t>(elements.begin(), elements.end());
+  auto sorted = std::vector<std::uint64_t>(flat.keys().begin(), flat.keys().end());
+
+  // Half of the lookups hit
+  auto queries = std::vector<std::uint64_t>(lookups);
+  for (auto& query : queries) {
+    query = rng() % 2 ? keys[rng() % n] : rng();
+  }
+
+  std::printf("%zu elements, %zu lookups\n", n, lookups);
+  bench::report(("  std::map::find, n = " + std::to_string(n)).c_str(), bench::median_ns([&] {
+    auto sum = std::uint64_t(0);
+    for (auto query : queries) {
+      auto it = tree.find(query);
+      sum += it == tree.end() ? 0 : it->second;
+    }
+    bench::do_not_optimize(sum);
+  }));
+  bench::report(("  std::lower_bound, n = " + std::to_string(n)).c_str(), bench::median_ns([&] {
+    auto sum = std::uint64_t(0);
+    for (auto query : queries) {
+      auto it = std::lower_bound(sorted.begin(), sorted.end(), query);
+      sum += it != sorted.end() and *it == query ? *it / 2 : 0;
+    }
+    bench::do_not_optimize(sum);
+  }));
+  bench::report(("  flat_map::find, n = " + std::to_string(n)).c_str(), bench::median_ns([&] {
+    auto sum = std::uint64_t(0);
+    for (auto query : queries) {
+      auto it = flat.find(query);
+      sum += it == flat.end() ? 0 : it->second;
+    }
+    bench::do_not_optimize(sum);
+  }));
+}
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+  for (std::size_t n : { 64, 4096, 1 << 16, 1 << 20 }) {
+    run(n);
+  }
+}
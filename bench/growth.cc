@@ -0,0 +1,145 @@
+// Compares growth policies by peak RSS, number of reallocations and unused capacity,
+// and how much allocate_at_least saves by turning size class rounding into capacity.
+//
+// Peak RSS can only go up over the lifetime of a process,
+// so every workload runs in its own forked child process.
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "constexpr_containers/allocator.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+std::size_t allocations = 0;
+
+template<typename T, typename Base = std::allocator<T>>
+struct counting_allocator
+{
+  using value_type = T;
+
+  template<typename U>
+  struct rebind
+  {
+    using other =
+      counting_allocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+  };
+
+  counting_allocator() = default;
+  template<typename U, typename OtherBase>
+  counting_allocator(const counting_allocator<U, OtherBase>&) noexcept
+  {}
+
+  cec::allocation_result<T*> allocate_at_least(std::size_t n)
+  {
+    ++allocations;
+    auto base = Base();
+    return cec::allocate_at_least(base, n);
+  }
+  T* allocate(std::size_t n) { return allocate_at_least(n).ptr; }
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    auto base = Base();
+    std::allocator_traits<Base>::deallocate(base, p, n);
+  }
+
+  friend bool operator==(const counting_allocator&, const counting_allocator&) = default;
+};
+
+// One big vector
+template<typename Policy, typename Base = std::allocator<int>>
+void
+one_vector(std::size_t& size, std::size_t& capacity)
+{
+  cec::vector<int, counting_allocator<int, Base>, Policy> v;
+  for (std::size_t i = 0; i < 10'000'000; ++i) {
+    v.push_back(int(i));
+  }
+  bench::do_not_optimize(v.data());
+  size = v.size();
+  capacity = v.capacity();
+}
+
+// Many medium vectors growing side by side, so freed blocks can be reused by the others
+template<typename Policy, typename Base = std::allocator<int>>
+void
+many_vectors(std::size_t& size, std::size_t& capacity)
+{
+  constexpr std::size_t count = 1000;
+  auto vs = std::make_unique<cec::vector<int, counting_allocator<int, Base>, Policy>[]>(count);
+  for (std::size_t i = 0; i < 10'000; ++i) {
+    for (std::size_t j = 0; j < count; ++j) {
+      vs[j].push_back(int(i));
+    }
+  }
+  size = capacity = 0;
+  for (std::size_t j = 0; j < count; ++j) {
+    bench::do_not_optimize(vs[j].data());
+    size += vs[j].size();
+    capacity += vs[j].capacity();
+  }
+}
+
+void
+run(const char* name, void (*workload)(std::size_t&, std::size_t&))
+{
+  std::fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0) {
+    std::size_t size = 0;
+    std::size_t capacity = 0;
+    auto ns = bench::median_ns([&] { workload(size, capacity); }, 1);
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%-46s %10.1f ms %8zu allocs %10ld KiB peak RSS %6.1f%% slack\n",
+                name,
+                ns / 1e6,
+                allocations / 2, // median_ns runs the workload twice
+                usage.ru_maxrss,
+                100.0 * double(capacity - size) / double(capacity));
+    std::fflush(stdout);
+    _exit(0);
+  }
+  waitpid(pid, nullptr, 0);
+}
+
+} // namespace
+
+int
+main()
+{
+  namespace growth = cec::growth;
+
+  std::printf("push_back 10M ints into one vector\n");
+  run("  doubling", one_vector<growth::doubling>);
+  run("  one_and_a_half", one_vector<growth::one_and_a_half>);
+  run("  size_class<doubling>", one_vector<growth::size_class<>>);
+  run("  size_class<one_and_a_half>", one_vector<growth::size_class<growth::one_and_a_half>>);
+  run("  fixed_increment<65536>", one_vector<growth::fixed_increment<65536>>);
+  run("  doubling, malloc_allocator", one_vector<growth::doubling, cec::malloc_allocator<int>>);
+  run("  doubling, size_class_allocator",
+      one_vector<growth::doubling, cec::size_class_allocator<int>>);
+
+  std::printf("push_back 10k ints into each of 1000 vectors, round robin\n");
+  run("  doubling", many_vectors<growth::doubling>);
+  run("  one_and_a_half", many_vectors<growth::one_and_a_half>);
+  run("  size_class<doubling>", many_vectors<growth::size_class<>>);
+  run("  size_class<one_and_a_half>", many_vectors<growth::size_class<growth::one_and_a_half>>);
+  run("  fixed_increment<1024>", many_vectors<growth::fixed_increment<1024>>);
+  run("  doubling, malloc_allocator", many_vectors<growth::doubling, cec::malloc_allocator<int>>);
+  run("  fixed_increment<1024>, malloc_allocator",
+      many_vectors<growth::fixed_increment<1024>, cec::malloc_allocator<int>>);
+  run("  doubling, size_class_allocator",
+      many_vectors<growth::doubling, cec::size_class_allocator<int>>);
+  run("  fixed_increment<1024>, size_class_allocator",
+      many_vectors<growth::fixed_increment<1024>, cec::size_class_allocator<int>>);
+}
@@ -0,0 +1,83 @@
+// Measures inserting whole batches at once, from forward ranges (a std::list)
+// and from input ranges (a std::istream_iterator-like generator), at the end and in the middle.
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t batch = 100'000;
+
+// A single pass range producing 0, 1, ..., count - 1
+struct counter
+{
+  using iterator_category = std::input_iterator_tag;
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const int*;
+  using reference = int;
+
+  int value;
+
+  int operator*() const { return value; }
+  counter& operator++()
+  {
+    ++value;
+    return *this;
+  }
+  void operator++(int) { ++value; }
+  bool operator==(const counter& other) const { return value == other.value; }
+};
+
+static_assert(std::input_iterator<counter> and not std::forward_iterator<counter>);
+
+template<typename Vector>
+void
+run(const char* name)
+{
+  std::list<int> list(batch, 1);
+  auto input_range = [] { return std::ranges::subrange(counter{ 0 }, counter{ int(batch) }); };
+
+  std::printf("%s\n", name);
+  bench::report("  append a list", bench::median_ns([&] {
+    Vector v(16);
+    v.insert(v.end(), list.begin(), list.end());
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("  insert a list in the middle", bench::median_ns([&] {
+    Vector v(batch);
+    v.insert(v.begin() + batch / 2, list.begin(), list.end());
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("  append an input range", bench::median_ns([&] {
+    Vector v(16);
+    auto rg = input_range();
+    v.insert(v.end(), rg.begin(), rg.end());
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("  insert an input range in the middle", bench::median_ns([&] {
+    Vector v(batch);
+    auto rg = input_range();
+    v.insert(v.begin() + batch / 2, rg.begin(), rg.end());
+    bench::do_not_optimize(v.data());
+  }));
+}
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+
+  run<cec::vector<int>>("cec::vector<int>");
+  run<std::vector<int>>("std::vector<int>");
+}
@@ -0,0 +1,57 @@
+// Measures filling a fresh buffer from an external source (here, memcpy from a "socket" buffer),
+// where value-initializing the elements first is a wasted pass over the whole buffer.
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t n = 64 << 20;
+
+std::vector<char> source(n, 'x');
+
+// Stands in for read(2), fills p with up to count bytes and returns how many it wrote
+std::size_t
+read_into(char* p, std::size_t count)
+{
+  std::memcpy(p, source.data(), count);
+  return count;
+}
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+
+  bench::report("std::vector<char>, resize + read", bench::median_ns([] {
+    std::vector<char> v;
+    v.resize(n);
+    v.resize(read_into(v.data(), n));
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("cec::vector<char>, resize + read", bench::median_ns([] {
+    cec::vector<char> v;
+    v.resize(n);
+    v.resize(read_into(v.data(), n));
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("cec::vector<char>, resize_for_overwrite + read", bench::median_ns([] {
+    cec::vector<char> v;
+    v.resize_for_overwrite(n);
+    v.resize(read_into(v.data(), n));
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("cec::vector<char>, resize_and_overwrite", bench::median_ns([] {
+    cec::vector<char> v;
+    v.resize_and_overwrite(n, read_into);
+    bench::do_not_optimize(v.data());
+  }));
+}
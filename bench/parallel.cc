@@ -0,0 +1,46 @@
+// Measures a feature transform (out = a * scale + b, with a little extra arithmetic) over
+// multi-million element vectors, sequentially and on default_thread_pool().
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+
+#include "bench.h"
+#include "constexpr_containers/parallel.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t n = 1 << 24;
+
+constexpr auto feature = [](float a, float b) { return std::sqrt(a * 0.5f + b * b) + 1.0f; };
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+  cec::vector<float> a(n, 2.0f);
+  cec::vector<float> b(n, 3.0f);
+  cec::vector<float> out(n);
+
+  bench::report("zip_transform, sequential", bench::median_ns([&] {
+    cec::zip_transform(a.begin(), a.end(), out.begin(), feature, b.begin());
+    bench::do_not_optimize(out.data());
+  }));
+  for (std::size_t threads : { 2, 4, 0 }) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "zip_transform, parallel{ .threads = %zu }", threads);
+    bench::report(name, bench::median_ns([&] {
+      cec::zip_transform(
+        cec::parallel{ .threads = threads }, a.begin(), a.end(), out.begin(), feature, b.begin());
+      bench::do_not_optimize(out.data());
+    }));
+  }
+}
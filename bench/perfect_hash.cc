@@ -0,0 +1,127 @@
+// Measures lookups in perfect_hash_maps built at compile time, against std::unordered_map,
+// for string keywords and sparse integer opcodes, in nanoseconds and lookups per second.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/perfect_hash.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t keyword_count = 1000;
+constexpr std::size_t opcode_count = 4000;
+constexpr std::size_t lookups = 1 << 16;
+
+// "kw0", "kw1", ... "kw999", each padded to its own 8 bytes so they can be string_views into it
+constexpr auto keyword_chars = [] {
+  auto chars = std::array<char, keyword_count * 8>{};
+  for (std::size_t i = 0; i < keyword_count; ++i) {
+    auto p = chars.data() + i * 8;
+    *p++ = 'k';
+    *p++ = 'w';
+    auto digits = std::array<char, 4>{};
+    auto n = std::size_t(0);
+    for (auto x = i; n == 0 or x != 0; x /= 10) {
+      digits[n++] = char('0' + x % 10);
+    }
+    while (n != 0) {
+      *p++ = digits[--n];
+    }
+  }
+  return chars;
+}();
+
+constexpr std::string_view
+keyword(std::size_t i)
+{
+  auto p = keyword_chars.data() + i * 8;
+  return std::string_view(p, std::string_view(p, 8).find('\0'));
+}
+
+constexpr std::uint32_t
+opcode(std::size_t i)
+{
+  return std::uint32_t(i * 7919 + 13);
+}
+
+constexpr auto keywords = cec::make_perfect_hash_map<[] {
+  cec::vector<std::pair<std::string_view, std::uint32_t>> v;
+  for (std::size_t i = 0; i < keyword_count; ++i) {
+    v.emplace_back(keyword(i), std::uint32_t(i));
+  }
+  return v;
+}>();
+
+constexpr auto opcodes = cec::make_perfect_hash_map<[] {
+  cec::vector<std::pair<std::uint32_t, std::uint32_t>> v;
+  for (std::size_t i = 0; i < opcode_count; ++i) {
+    v.emplace_back(opcode(i), std::uint32_t(i));
+  }
+  return v;
+}>();
+
+template<typename Key, typename Map>
+void
+run(const char* name, const Map& map, const std::vector<Key>& queries)
+{
+  auto ns = bench::median_ns([&] {
+    auto sum = std::uint32_t(0);
+    for (const auto& query : queries) {
+      if constexpr (requires { map.end(); }) {
+        auto it = map.find(query);
+        sum += it == map.end() ? 0 : it->second;
+      } else {
+        auto value = map.find(query);
+        sum += value == nullptr ? 0 : *value;
+      }
+    }
+    bench::do_not_optimize(sum);
+  });
+  bench::report(name, ns);
+  std::printf("%-60s %14.1f M/s\n", "", double(queries.size()) * 1e3 / ns);
+}
+
+} // namespace
+
+int
+main()
+{
+  auto rng = std::mt19937(1);
+
+  auto keyword_map = std::unordered_map<std::string_view, std::uint32_t>();
+  auto keyword_queries = std::vector<std::string_view>();
+  for (std::size_t i = 0; i < keyword_count; ++i) {
+    keyword_map.emplace(keyword(i), std::uint32_t(i));
+  }
+  for (std::size_t i = 0; i < lookups; ++i) {
+    keyword_queries.push_back(keyword(rng() % keyword_count));
+  }
+
+  auto opcode_map = std::unordered_map<std::uint32_t, std::uint32_t>();
+  auto opcode_queries = std::vector<std::uint32_t>();
+  for (std::size_t i = 0; i < opcode_count; ++i) {
+    opcode_map.emplace(opcode(i), std::uint32_t(i));
+  }
+  for (std::size_t i = 0; i < lookups; ++i) {
+    // One in four misses
+    opcode_queries.push_back(opcode(rng() % opcode_count) + (rng() % 4 == 0 ? 1 : 0));
+  }
+
+  std::printf("%zu lookups\n", lookups);
+  run("  std::unordered_map<string_view>, 1000 keywords", keyword_map, keyword_queries);
+  run("  perfect_hash_map<string_view>, 1000 keywords", keywords, keyword_queries);
+  run("  std::unordered_map<uint32_t>, 4000 opcodes", opcode_map, opcode_queries);
+  run("  perfect_hash_map<uint32_t>, 4000 opcodes", opcodes, opcode_queries);
+}
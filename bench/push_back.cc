@@ -0,0 +1,103 @@
+// Measures push_back-heavy workloads, where most of the time goes into growing the buffer.
+// Each element type comes in a trivially relocatable flavour and an otherwise identical one
+// that has to be relocated one element at a time, to show what the memcpy path buys.
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+// Trivially copyable, so trivially relocatable without opting in
+struct pod
+{
+  int data[4];
+};
+
+// Same layout as pod, but the user-provided move constructor hides that
+struct pod_slow
+{
+  int data[4];
+
+  pod_slow(int i) noexcept
+    : data{ i, i, i, i }
+  {}
+  pod_slow(const pod_slow& other) noexcept = default;
+  pod_slow(pod_slow&& other) noexcept
+    : data{ other.data[0], other.data[1], other.data[2], other.data[3] }
+  {}
+};
+
+// unique_ptr-like handle
+template<bool Relocatable>
+struct handle
+{
+  int* ptr;
+
+  handle(int i)
+    : ptr(new int(i))
+  {}
+  handle(handle&& other) noexcept
+    : ptr(other.ptr)
+  {
+    other.ptr = nullptr;
+  }
+  ~handle() { delete ptr; }
+};
+
+} // namespace
+
+template<>
+struct constexpr_containers::is_trivially_relocatable<handle<true>> : std::true_type
+{};
+
+namespace {
+
+template<typename T>
+constexpr T
+make(std::size_t i)
+{
+  if constexpr (std::is_aggregate_v<T>) {
+    return T{ { int(i), int(i), int(i), int(i) } };
+  } else {
+    return T(int(i));
+  }
+}
+
+template<typename Vector>
+void
+run(const char* name, std::size_t n)
+{
+  bench::report(name, bench::median_ns([n] {
+    Vector v;
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(make<typename Vector::value_type>(i));
+    }
+    bench::do_not_optimize(v.data());
+  }));
+}
+
+} // namespace
+
+int
+main()
+{
+  constexpr std::size_t n = 1000000;
+  bench::keep_heap_mapped();
+
+  run<cec::vector<pod>>("cec::vector<pod> (memcpy)", n);
+  run<cec::vector<pod_slow>>("cec::vector<pod_slow> (per-element)", n);
+  run<std::vector<pod>>("std::vector<pod>", n);
+
+  run<cec::vector<int>>("cec::vector<int> (memcpy)", n);
+  run<std::vector<int>>("std::vector<int>", n);
+
+  run<cec::vector<handle<true>>>("cec::vector<handle> (memcpy, opted in)", n);
+  run<cec::vector<handle<false>>>("cec::vector<handle> (per-element)", n);
+  run<std::vector<handle<false>>>("std::vector<handle>", n);
+}
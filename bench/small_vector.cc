@@ -0,0 +1,83 @@
+// Counts the allocations saved by small_vector when most vectors hold only a few elements,
+// and measures building and destroying lots of short vectors.
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/small_vector.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+std::size_t allocations = 0;
+
+template<typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() = default;
+  template<typename U>
+  counting_allocator(const counting_allocator<U>&) noexcept
+  {}
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+  friend bool operator==(const counting_allocator&, const counting_allocator&) = default;
+};
+
+// Mostly fewer than 8 elements, with the occasional outlier
+std::vector<std::size_t>
+make_sizes(std::size_t count)
+{
+  std::mt19937 rng(42);
+  std::geometric_distribution<std::size_t> dist(0.3);
+  std::vector<std::size_t> sizes(count);
+  for (auto& size : sizes) {
+    size = dist(rng);
+  }
+  return sizes;
+}
+
+template<typename Vector>
+void
+run(const char* name, const std::vector<std::size_t>& sizes)
+{
+  allocations = 0;
+  auto ns = bench::median_ns(
+    [&] {
+      std::vector<Vector> vs(sizes.size());
+      for (std::size_t i = 0; i < sizes.size(); ++i) {
+        for (std::size_t j = 0; j < sizes[i]; ++j) {
+          vs[i].push_back(int(j));
+        }
+      }
+      bench::do_not_optimize(vs.data());
+    },
+    1);
+  // median_ns runs the workload twice
+  std::printf("%-48s %14.0f ns %10zu allocations\n", name, ns, allocations / 2);
+}
+
+} // namespace
+
+int
+main()
+{
+  auto sizes = make_sizes(1'000'000);
+
+  run<cec::vector<int, counting_allocator<int>>>("cec::vector<int>", sizes);
+  run<cec::small_vector<int, 4, counting_allocator<int>>>("cec::small_vector<int, 4>", sizes);
+  run<cec::small_vector<int, 8, counting_allocator<int>>>("cec::small_vector<int, 8>", sizes);
+  run<cec::small_vector<int, 16, counting_allocator<int>>>("cec::small_vector<int, 16>", sizes);
+}
@@ -0,0 +1,153 @@
+// The main benchmark suite, comparing cec::vector against std::vector operation by operation,
+// for trivial, non-trivial and move-only elements, with std::allocator and with pmr.
+//
+// Run with --json=<file> to also write the results as JSON.
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t n = 100'000;
+constexpr std::size_t middle_ops = 1'000;
+
+template<typename T>
+T
+make(std::size_t i)
+{
+  if constexpr (std::is_same_v<T, std::string>) {
+    // Too long for the small string optimization
+    return "a string which lives on the heap #" + std::to_string(i);
+  } else if constexpr (std::is_same_v<T, std::unique_ptr<int>>) {
+    return std::make_unique<int>(int(i));
+  } else {
+    return T(i);
+  }
+}
+
+template<typename Vector>
+Vector
+filled(std::size_t count)
+{
+  Vector v;
+  v.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    v.push_back(make<typename Vector::value_type>(i));
+  }
+  return v;
+}
+
+template<typename Vector>
+void
+run(const std::string& name)
+{
+  using T = typename Vector::value_type;
+  auto report = [&](const char* op, double ns) { bench::report((name + "/" + op).c_str(), ns); };
+
+  report("push_back", bench::median_ns([] {
+    Vector v;
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(make<T>(i));
+    }
+    bench::do_not_optimize(v.data());
+  }));
+
+  report("emplace_back", bench::median_ns([] {
+    Vector v;
+    for (std::size_t i = 0; i < n; ++i) {
+      v.emplace_back(make<T>(i));
+    }
+    bench::do_not_optimize(v.data());
+  }));
+
+  report("reserve + push_back", bench::median_ns([] {
+    Vector v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(make<T>(i));
+    }
+    bench::do_not_optimize(v.data());
+  }));
+
+  Vector v;
+  report("insert in the middle", bench::median_ns([&] { v = filled<Vector>(n / 10); }, [&] {
+    for (std::size_t i = 0; i < middle_ops; ++i) {
+      v.insert(v.begin() + v.size() / 2, make<T>(i));
+    }
+    bench::do_not_optimize(v.data());
+  }));
+
+  report("erase in the middle", bench::median_ns([&] { v = filled<Vector>(n / 10); }, [&] {
+    for (std::size_t i = 0; i < middle_ops; ++i) {
+      v.erase(v.begin() + v.size() / 2);
+    }
+    bench::do_not_optimize(v.data());
+  }));
+
+  if constexpr (std::is_copy_assignable_v<T>) {
+    auto src = filled<Vector>(n);
+    report("copy assign", bench::median_ns([&] { v = Vector(); }, [&] {
+      v = src;
+      bench::do_not_optimize(v.data());
+    }));
+  }
+
+  Vector src;
+  report("move assign", bench::median_ns([&] { src = filled<Vector>(n); }, [&] {
+    v = std::move(src);
+    bench::do_not_optimize(v.data());
+  }));
+
+  report("clear", bench::median_ns([&] { v = filled<Vector>(n); }, [&] {
+    v.clear();
+    bench::do_not_optimize(v.data());
+  }));
+
+  v = filled<Vector>(n);
+  report("iterate", bench::median_ns([&] {
+    std::size_t sum = 0;
+    for (const auto& elem : v) {
+      if constexpr (std::is_same_v<T, std::string>) {
+        sum += elem.size();
+      } else if constexpr (std::is_same_v<T, std::unique_ptr<int>>) {
+        sum += std::size_t(*elem);
+      } else {
+        sum += std::size_t(elem);
+      }
+    }
+    bench::do_not_optimize(sum);
+  }));
+}
+
+template<typename T>
+void
+run_all(const std::string& type)
+{
+  run<std::vector<T>>("std::vector<" + type + ">");
+  run<cec::vector<T>>("cec::vector<" + type + ">");
+  run<std::pmr::vector<T>>("std::pmr::vector<" + type + ">");
+  run<cec::pmr::vector<T>>("cec::pmr::vector<" + type + ">");
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  bench::keep_heap_mapped();
+
+  run_all<int>("int");
+  run_all<std::string>("std::string");
+  run_all<std::unique_ptr<int>>("std::unique_ptr<int>");
+
+  return bench::write_json(argc, argv);
+}
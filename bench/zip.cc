@@ -0,0 +1,76 @@
+// Measures zip_transform over contiguous float vectors at -O2, against std::transform,
+// and appending its results through a back_insert_iterator.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/simd_transform.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t n = 1 << 20;
+
+constexpr auto axpy = [](auto a, auto b) { return a * 2.0f + b; };
+constexpr auto norm = [](auto a, auto b) {
+  using std::sqrt; // std::experimental::sqrt is found by ADL
+  return sqrt(a * a + b * b);
+};
+
+} // namespace
+
+int
+main()
+{
+  bench::keep_heap_mapped();
+
+  std::vector<float> a(n, 2.0f);
+  std::vector<float> b(n, 3.0f);
+  std::vector<float> out(n);
+
+  auto run = [&](const char* name, auto op) {
+    bench::report(name, bench::median_ns([&] {
+      op();
+      bench::do_not_optimize(out.data());
+    }));
+  };
+
+  run("a * 2 + b, std::transform", [&] {
+    std::transform(a.begin(), a.end(), b.begin(), out.begin(), axpy);
+  });
+  run("a * 2 + b, zip_transform", [&] {
+    cec::zip_transform(a.begin(), a.end(), out.begin(), axpy, b.begin());
+  });
+  run("a * 2 + b, zip_transform + vectorizable", [&] {
+    cec::zip_transform(a.begin(), a.end(), out.begin(), cec::simd::vectorizable{ axpy }, b.begin());
+  });
+  run("sqrt(a * a + b * b), std::transform", [&] {
+    std::transform(a.begin(), a.end(), b.begin(), out.begin(), norm);
+  });
+  run("sqrt(a * a + b * b), zip_transform", [&] {
+    cec::zip_transform(a.begin(), a.end(), out.begin(), norm, b.begin());
+  });
+  run("sqrt(a * a + b * b), zip_transform + vectorizable", [&] {
+    cec::zip_transform(a.begin(), a.end(), out.begin(), cec::simd::vectorizable{ norm }, b.begin());
+  });
+
+  bench::report("push_back loop", bench::median_ns([&] {
+    cec::vector<float> v;
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(axpy(a[i], b[i]));
+    }
+    bench::do_not_optimize(v.data());
+  }));
+  bench::report("back_inserter, zip_transform", bench::median_ns([&] {
+    cec::vector<float> v;
+    cec::zip_transform(a.begin(), a.end(), std::back_inserter(v), axpy, b.begin());
+    bench::do_not_optimize(v.data());
+  }));
+}
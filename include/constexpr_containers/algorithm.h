@@ -1,11 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <new>
+#include <ranges>
 #include <type_traits>
 #include <utility>
 
+#include "constexpr_containers/launder_iterator.h"
+#include "constexpr_containers/simd.h"
+#include "constexpr_containers/type_traits.h"
+
 namespace constexpr_containers {
 
 template<typename Iterator>
@@ -20,19 +31,92 @@ using iterator_value_t = typename std::iterator_traits<Iterator>::value_type;
 //   stuff
 // zip_transform(dst, fst, fst_end, [snd, third, rest...], n-ary op)
 //   Applies op on each element in the specified ranges, if snd, third, etc are
-//   at least as long as fst..fst_end, inserting results into dst
+//   at least as long as fst..fst_end, inserting results into dst.
+//   Outside constant evaluation, when op is a simd::vectorizable (see simd_transform.h), every
+//   range is contiguous and each input either is dst or doesn't overlap it, op is run a whole
+//   simd at a time. Otherwise it's a plain loop, left for the compiler to vectorize.
+//   With random access inputs and a back_insert_iterator, the container grows once up front
+//   (with append_range if it has one, or reserve), instead of once in a while during the loop.
 // zip_foreach(fst, fst_end, [snd, third, rest...], n-ary op)
 //   Applies op on each element in the specified ranges, if snd, third, etc are
 //   at least as long as fst..fst_end
+// equal(a, a_end, b, b_end)
+//   Like std::equal, but outside constant evaluation, contiguous ranges of integers, enums (without
+//   user declared comparison operators) or pointers are compared with a single memcmp
+// lexicographical_compare_three_way(a, a_end, b, b_end)
+//   Like std::lexicographical_compare_three_way, but outside constant evaluation, contiguous
+//   ranges of the same elements as for equal are compared with memcmp (unsigned bytes),
+//   or by finding the first mismatching byte with simd::mismatch_bytes (everything else).
+//   Elements without <=> are compared with <, giving a std::weak_ordering.
+// branchless_lower_bound(first, last, value, [comp])
+// branchless_upper_bound(first, last, value, [comp])
+//   Like std::lower_bound and std::upper_bound, but the loop has no data dependent branches, so
+//   it doesn't stall on mispredictions when looking up random keys
 // uninitialized_copy(src, src_end, dst)
 //   Like std::uninitialized_copy, but supports a custom allocator
 // uninitialized_move(src, src_end, dst)
 //   Like std::uninitialized_move, but supports a custom allocator
 // uninitialized_move_if_noexcept(src, src_end, dst)
 //   Like the above but with move_if_noexcept
+// uninitialized_construct(dst, dst_end, alloc, args...)
+//   Constructs every element in dst..dst_end from args (value-initializes if there are none)
+// uninitialized_default_construct(dst, dst_end, alloc)
+//   Default-initializes every element in dst..dst_end, which leaves trivial types uninitialized.
+//   Like std::uninitialized_default_construct, but value-initializes when the allocator customizes
+//   construct (it can't be asked for default-initialization) or during constant evaluation
+//   (where reading an uninitialized value isn't allowed anyway).
+// destroy_launder(first, last, alloc)
+//   Destroys every element in first..last, a no-op for trivially destructible types
+//   as long as the allocator doesn't customize destroy
+// uninitialized_relocate_launder(src, src_end, dst, alloc)
+//   Moves (or copies, if moving could throw) src..src_end into dst, then destroys src..src_end.
+//   Trivially relocatable types are relocated with a single memcpy outside constant evaluation.
 //
 // *_launder
-//   Like the above, but where the pointers in src..src_end are laundered
+//   Like the above, but where the pointers in src..src_end are laundered (with maybe_launder)
+//
+// copy_launder(src, src_end, dst)
+//   Copy-assigns src..src_end onto dst, front to back
+// move_if_noexcept_launder(src, src_end, dst)
+//   Move-assigns src..src_end onto dst, front to back
+// move_if_noexcept_launder_backward(src, src_end, dst_end)
+//   Move-assigns src..src_end onto the range ending at dst_end, back to front
+// uninitialized_move_if_noexcept_launder_backward(src, src_end, dst_end, alloc)
+//   Move-constructs src..src_end into the range ending at dst_end, back to front
+//
+// All uninitialized_* algorithms destroy whatever they have constructed if a constructor throws.
+//
+// Outside constant evaluation, all of the copying / moving algorithms above turn into a single
+// memcpy (or memmove, for the ones that may overlap) when both ranges are contiguous,
+// the elements are trivially copyable and the allocator doesn't customize construct.
+//
+// The *_in_place algorithms manage the elements first..end of a container's buffer, which has to
+// have room after end for everything they add, so that every kind of vector can share them.
+// They take end by reference, and keep it pointing past the last element as they construct and
+// destroy elements, even when they throw.
+//
+// insert_one_in_place(pos, end, value, alloc)
+//   Shifts pos..end back by one, then assigns (or constructs, at the end) value at pos
+// insert_fill_in_place(pos, end, count, value, alloc)
+//   Inserts count copies of value at pos. value mustn't be one of the elements.
+// insert_copy_in_place(pos, end, src, count, alloc)
+//   Inserts copies of the count elements starting at src at pos. They mustn't be in the buffer.
+// assign_in_place(first, end, src, count, alloc)
+//   Replaces first..end with copies of the count elements starting at src, assigning over the
+//   elements already there
+// erase_in_place(pos, pos_end, end, alloc)
+//   Erases pos..pos_end, moving everything after it down
+// erase_if_in_place(first, end, pred, alloc)
+//   Erases every element for which pred returns true, keeping the order of the rest, and returns
+//   how many it erased. pred is called exactly once per element, front to back. Outside constant
+//   evaluation, memcpy relocatable elements are relocated rather than move-assigned, and erasing
+//   arithmetic elements equal to a value (with detail::equal_to_value, which erase(c, value)
+//   converts to the element type where that compares the same) uses simd::remove_equal.
+//   If pred throws, the elements it has already returned true for are erased.
+// unordered_erase_if_in_place(first, end, pred, alloc)
+//   Like erase_if_in_place, but fills the gaps with elements from the back instead of shifting
+//   everything down, so the order of the remaining elements isn't kept. If pred throws, the
+//   elements it has already returned true for are erased too.
 
 template<std::input_or_output_iterator It, std::input_or_output_iterator It2>
 [[nodiscard]] constexpr //
@@ -54,6 +138,40 @@ template<std::input_or_output_iterator It, std::input_or_output_iterator It2>
   return Range{ std::forward<It>(begin), std::forward<It2>(end) };
 }
 
+namespace detail {
+
+template<typename OutputIt>
+inline constexpr bool is_back_insert_iterator_v = false;
+
+template<typename Container>
+inline constexpr bool is_back_insert_iterator_v<std::back_insert_iterator<Container>> = true;
+
+// back_insert_iterator's container member is protected, but the standard names it
+template<typename Container>
+struct back_insert_access : std::back_insert_iterator<Container>
+{
+  static constexpr Container& get(std::back_insert_iterator<Container>& it) noexcept
+  {
+    return *(it.*(&back_insert_access::container));
+  }
+};
+
+// Runtime only, whether each of the src..src + count either is dst..dst + count or doesn't overlap
+// it, so that results can be written a whole simd at a time
+template<typename T, typename... Ts>
+bool
+disjoint_or_same(std::size_t count, const T* dst, const Ts*... src) noexcept
+{
+  auto d = reinterpret_cast<std::uintptr_t>(dst);
+  auto d_end = d + count * sizeof(T);
+  return ((static_cast<const void*>(src) == static_cast<const void*>(dst) or
+           reinterpret_cast<std::uintptr_t>(src + count) <= d or
+           d_end <= reinterpret_cast<std::uintptr_t>(src)) and
+          ...);
+}
+
+} // namespace detail
+
 template<std::input_or_output_iterator OutputIt,
          std::input_iterator FstIt,
          typename Op,
@@ -62,6 +180,40 @@ constexpr //
   OutputIt
   zip_transform(FstIt fst, FstIt fst_end, OutputIt dst, Op op, RestIt... rest)
 {
+  constexpr auto random_access =
+    std::random_access_iterator<FstIt> and (std::random_access_iterator<RestIt> and ...);
+  if constexpr (random_access and detail::is_back_insert_iterator_v<OutputIt>) {
+    // Appending to a container: grow it once, instead of once in a while during the loop
+    using Container = typename OutputIt::container_type;
+    auto& c = detail::back_insert_access<Container>::get(dst);
+    auto count = fst_end - fst;
+    auto results = std::views::iota(std::iter_difference_t<FstIt>(0), count) |
+                   std::views::transform([&](auto i) { return op(fst[i], rest[i]...); });
+    if constexpr (requires { c.append_range(results); }) {
+      c.append_range(results);
+      return dst;
+    } else if constexpr (requires { c.reserve(c.capacity()); }) {
+      auto needed = c.size() + static_cast<std::size_t>(count);
+      if (needed > c.capacity()) {
+        // Geometrically, so that appending repeatedly stays amortized O(1)
+        c.reserve(std::max(needed, 2 * c.capacity()));
+      }
+    }
+  } else if constexpr (simd::detail::is_vectorizable_v<Op> and std::contiguous_iterator<FstIt> and
+                       std::contiguous_iterator<OutputIt> and
+                       (std::contiguous_iterator<RestIt> and ...)) {
+    if (not std::is_constant_evaluated()) {
+      auto count = static_cast<std::size_t>(fst_end - fst);
+      auto d = std::to_address(dst);
+      if (detail::disjoint_or_same(count, d, std::to_address(fst), std::to_address(rest)...)) {
+        // The loop below finishes off the elements which don't fill a whole simd
+        auto done = op.transform(count, d, std::to_address(fst), std::to_address(rest)...);
+        fst += std::iter_difference_t<FstIt>(done);
+        dst += std::iter_difference_t<OutputIt>(done);
+        ((rest += std::iter_difference_t<RestIt>(done)), ...);
+      }
+    }
+  }
   for (; fst != fst_end; ++dst, ++fst, (++rest, ...)) {
     *dst = op(*fst, *rest...);
   }
@@ -78,6 +230,256 @@ constexpr //
   }
 }
 
+namespace detail {
+
+// Whether comparing two E's calls a user declared operator rather than the built-in one.
+// Called like functions, the operators are only found by lookup, never the built-in ones.
+template<typename E>
+concept has_user_comparison =
+  requires(const E& a, const E& b) { operator==(a, b); } or
+  requires(const E& a, const E& b) { operator<=>(a, b); } or
+  requires(const E& a, const E& b) { operator<(a, b); };
+
+// Whether the elements of InputIt and InputIt2 compare equal exactly when their bytes do.
+// Enums only do if they're compared with the built-in operators.
+template<typename InputIt, typename InputIt2>
+inline constexpr bool is_bytewise_comparable_v = false;
+
+template<std::contiguous_iterator InputIt, std::contiguous_iterator InputIt2>
+inline constexpr bool is_bytewise_comparable_v<InputIt, InputIt2> =
+  std::is_same_v<std::remove_cv_t<iterator_value_t<InputIt>>,
+                 std::remove_cv_t<iterator_value_t<InputIt2>>> and
+  (std::is_integral_v<iterator_value_t<InputIt>> or
+   (std::is_enum_v<iterator_value_t<InputIt>> and
+    not has_user_comparison<iterator_value_t<InputIt>>) or
+   std::is_pointer_v<iterator_value_t<InputIt>>) and
+  std::has_unique_object_representations_v<iterator_value_t<InputIt>>;
+
+// Whether memcmp also orders T correctly, whatever the endianness
+template<typename T>
+inline constexpr bool is_memcmp_ordered_v =
+  sizeof(T) == 1 and (std::is_unsigned_v<T> or std::is_same_v<T, std::byte>);
+
+} // namespace detail
+
+template<std::input_iterator InputIt, std::input_iterator InputIt2>
+[[nodiscard]] constexpr //
+  bool
+  equal(InputIt a, InputIt a_end, InputIt2 b, InputIt2 b_end)
+{
+  if constexpr (detail::is_bytewise_comparable_v<InputIt, InputIt2>) {
+    if (not std::is_constant_evaluated()) {
+      auto size = a_end - a;
+      return size == b_end - b and
+             (size == 0 or std::memcmp(std::to_address(a),
+                                       std::to_address(b),
+                                       size * sizeof(iterator_value_t<InputIt>)) == 0);
+    }
+  }
+  return std::equal(a, a_end, b, b_end);
+}
+
+template<std::input_iterator InputIt, std::input_iterator InputIt2>
+[[nodiscard]] constexpr //
+  auto
+  lexicographical_compare_three_way(InputIt a, InputIt a_end, InputIt2 b, InputIt2 b_end)
+{
+  if constexpr (detail::is_bytewise_comparable_v<InputIt, InputIt2>) {
+    if (not std::is_constant_evaluated()) {
+      using T = std::remove_cv_t<iterator_value_t<InputIt>>;
+      auto a_size = static_cast<std::size_t>(a_end - a);
+      auto b_size = static_cast<std::size_t>(b_end - b);
+      auto common = std::min(a_size, b_size);
+      if constexpr (detail::is_memcmp_ordered_v<T>) {
+        auto cmp = common == 0 ? 0 : std::memcmp(std::to_address(a), std::to_address(b), common);
+        if (cmp != 0) {
+          return cmp <=> 0;
+        }
+      } else {
+        auto i = simd::mismatch_bytes(std::to_address(a), std::to_address(b), common * sizeof(T));
+        i /= sizeof(T);
+        if (i < common) {
+          return std::to_address(a)[i] <=> std::to_address(b)[i];
+        }
+      }
+      return a_size <=> b_size;
+    }
+  }
+  if constexpr (std::three_way_comparable_with<std::iter_reference_t<InputIt>,
+                                              std::iter_reference_t<InputIt2>>) {
+    return std::lexicographical_compare_three_way(a, a_end, b, b_end);
+  } else {
+    // Types with only operator< still get a weak ordering
+    return std::lexicographical_compare_three_way(
+      a, a_end, b, b_end, [](const auto& x, const auto& y) {
+        return x < y ? std::weak_ordering::less :
+               y < x ? std::weak_ordering::greater :
+                       std::weak_ordering::equivalent;
+      });
+  }
+}
+
+namespace detail {
+
+// Halves the range without branching on pred, which the compiler turns into conditional moves.
+// The branches of std::partition_point mispredict half the time on random lookups.
+template<std::random_access_iterator It, typename Pred>
+constexpr It
+branchless_partition_point(It first, It last, Pred& pred)
+{
+  auto size = last - first;
+  if (size == 0) {
+    return first;
+  }
+  while (size > 1) {
+    auto half = size / 2;
+    first = pred(first[half]) ? first + half : first;
+    size -= half;
+  }
+  return first + (pred(*first) ? 1 : 0);
+}
+
+} // namespace detail
+
+template<std::random_access_iterator It, typename T, typename Compare = std::less<>>
+[[nodiscard]] constexpr //
+  It
+  branchless_lower_bound(It first, It last, const T& value, Compare comp = {})
+{
+  auto pred = [&](const auto& elem) { return bool(comp(elem, value)); };
+  return detail::branchless_partition_point(first, last, pred);
+}
+
+template<std::random_access_iterator It, typename T, typename Compare = std::less<>>
+[[nodiscard]] constexpr //
+  It
+  branchless_upper_bound(It first, It last, const T& value, Compare comp = {})
+{
+  auto pred = [&](const auto& elem) { return not comp(value, elem); };
+  return detail::branchless_partition_point(first, last, pred);
+}
+
+namespace detail {
+
+// Whether constructing (or assigning, with Allocator = void) the elements of OutputIt from
+// a Ref obtained from InputIt is the same as copying bytes
+template<typename InputIt, typename OutputIt, typename Allocator, typename Ref>
+inline constexpr bool is_bytewise_copyable_v = false;
+
+template<std::contiguous_iterator InputIt,
+         std::contiguous_iterator OutputIt,
+         typename Allocator,
+         typename Ref>
+inline constexpr bool is_bytewise_copyable_v<InputIt, OutputIt, Allocator, Ref> =
+  std::is_same_v<std::remove_cv_t<iterator_value_t<InputIt>>, iterator_value_t<OutputIt>> and
+  std::is_trivially_copyable_v<iterator_value_t<OutputIt>> and
+  (std::is_void_v<Allocator> ?
+     std::is_trivially_assignable_v<iterator_value_t<OutputIt>&, Ref> :
+     std::is_trivially_constructible_v<iterator_value_t<OutputIt>, Ref> and
+       allocator_has_trivial_construct_v<Allocator, iterator_value_t<OutputIt>>);
+
+template<typename InputIt, typename OutputIt, typename Allocator>
+inline constexpr bool is_bytewise_copy_v =
+  is_bytewise_copyable_v<InputIt, OutputIt, Allocator, std::iter_reference_t<InputIt>>;
+
+template<typename InputIt, typename OutputIt, typename Allocator>
+inline constexpr bool is_bytewise_move_v =
+  is_bytewise_copyable_v<InputIt, OutputIt, Allocator, std::iter_rvalue_reference_t<InputIt>>;
+
+// Runtime only, src..src_end and dst must not overlap
+template<std::contiguous_iterator InputIt, std::contiguous_iterator OutputIt>
+OutputIt
+memcpy_range(InputIt src, InputIt src_end, OutputIt dst) noexcept
+{
+  auto count = src_end - src;
+  if (count > 0) {
+    std::memcpy(static_cast<void*>(std::to_address(dst)),
+                static_cast<const void*>(std::to_address(src)),
+                count * sizeof(iterator_value_t<OutputIt>));
+  }
+  return dst + count;
+}
+
+// Runtime only, src..src_end and dst may overlap
+template<std::contiguous_iterator InputIt, std::contiguous_iterator OutputIt>
+OutputIt
+memmove_range(InputIt src, InputIt src_end, OutputIt dst) noexcept
+{
+  auto count = src_end - src;
+  if (count > 0) {
+    std::memmove(static_cast<void*>(std::to_address(dst)),
+                 static_cast<const void*>(std::to_address(src)),
+                 count * sizeof(iterator_value_t<OutputIt>));
+  }
+  return dst + count;
+}
+
+} // namespace detail
+
+template<std::input_or_output_iterator It,
+         typename Allocator = std::allocator<iterator_value_t<It>>>
+constexpr //
+  void
+  destroy_launder(It first, It last, Allocator alloc) //
+  noexcept
+{
+  using T = iterator_value_t<It>;
+  if constexpr (std::is_trivially_destructible_v<T> and
+                allocator_has_trivial_destroy_v<Allocator, T>) {
+    return;
+  }
+  for (; first != last; ++first) {
+    std::allocator_traits<Allocator>::destroy(alloc, maybe_launder(first));
+  }
+}
+
+template<std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>,
+         typename... Args>
+constexpr //
+  OutputIt
+  uninitialized_construct(OutputIt dst, OutputIt dst_end, Allocator alloc, const Args&... args)
+{
+  auto dst_begin = dst;
+  try {
+    for (; dst != dst_end; ++dst) {
+      std::allocator_traits<Allocator>::construct(alloc, dst, args...);
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
+  }
+  return dst;
+}
+
+template<std::contiguous_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_default_construct(OutputIt dst, OutputIt dst_end, Allocator alloc)
+{
+  using T = iterator_value_t<OutputIt>;
+  if (std::is_constant_evaluated() or not allocator_has_trivial_construct_v<Allocator, T>) {
+    return uninitialized_construct(dst, dst_end, alloc);
+  }
+  if constexpr (std::is_trivially_default_constructible_v<T> and
+                std::is_trivially_destructible_v<T>) {
+    // Nothing to do, the allocation already implicitly created the objects
+    return dst_end;
+  } else {
+    auto dst_begin = dst;
+    try {
+      for (; dst != dst_end; ++dst) {
+        ::new (static_cast<void*>(std::to_address(dst))) T;
+      }
+    } catch (...) {
+      destroy_launder(dst_begin, dst, alloc);
+      throw;
+    }
+    return dst;
+  }
+}
+
 template<std::input_iterator InputIt,
          std::input_or_output_iterator OutputIt,
          typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
@@ -85,8 +487,19 @@ constexpr //
   OutputIt
   uninitialized_copy(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
 {
-  for (; src != src_end; ++src, ++dst) {
-    std::allocator_traits<Allocator>::construct(alloc, dst, *src);
+  if constexpr (detail::is_bytewise_copy_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_begin = dst;
+  try {
+    for (; src != src_end; ++src, ++dst) {
+      std::allocator_traits<Allocator>::construct(alloc, dst, *src);
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
   }
   return dst;
 }
@@ -98,8 +511,19 @@ constexpr //
   OutputIt
   uninitialized_move(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
 {
-  for (; src != src_end; ++src, ++dst) {
-    std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*src));
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_begin = dst;
+  try {
+    for (; src != src_end; ++src, ++dst) {
+      std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*src));
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
   }
   return dst;
 }
@@ -111,8 +535,19 @@ constexpr //
   OutputIt
   uninitialized_move_if_noexcept(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
 {
-  for (; src != src_end; ++src, ++dst) {
-    std::allocator_traits<Allocator>::construct(alloc, dst, std::move_if_noexcept(*src));
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_begin = dst;
+  try {
+    for (; src != src_end; ++src, ++dst) {
+      std::allocator_traits<Allocator>::construct(alloc, dst, std::move_if_noexcept(*src));
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
   }
   return dst;
 }
@@ -124,8 +559,19 @@ constexpr //
   OutputIt
   uninitialized_copy_launder(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
 {
-  for (; src != src_end; ++src, ++dst) {
-    std::allocator_traits<Allocator>::construct(alloc, dst, *std::launder(src));
+  if constexpr (detail::is_bytewise_copy_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_begin = dst;
+  try {
+    for (; src != src_end; ++src, ++dst) {
+      std::allocator_traits<Allocator>::construct(alloc, dst, *maybe_launder(src));
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
   }
   return dst;
 }
@@ -137,8 +583,19 @@ constexpr //
   OutputIt
   uninitialized_move_launder(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
 {
-  for (; src != src_end; ++src, ++dst) {
-    std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*std::launder(src)));
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_begin = dst;
+  try {
+    for (; src != src_end; ++src, ++dst) {
+      std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*maybe_launder(src)));
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
   }
   return dst;
 }
@@ -153,30 +610,97 @@ constexpr //
                                          OutputIt dst,
                                          Allocator alloc)
 {
-  for (; src != src_end; ++src, ++dst) {
-    std::allocator_traits<Allocator>::construct(
-      alloc, dst, std::move_if_noexcept(*std::launder(src)));
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_begin = dst;
+  try {
+    for (; src != src_end; ++src, ++dst) {
+      std::allocator_traits<Allocator>::construct(
+        alloc, dst, std::move_if_noexcept(*maybe_launder(src)));
+    }
+  } catch (...) {
+    destroy_launder(dst_begin, dst, alloc);
+    throw;
   }
   return dst;
 }
 
-template<std::input_iterator InputIt,
-         std::input_or_output_iterator OutputIt,
+template<std::contiguous_iterator InputIt,
+         std::contiguous_iterator OutputIt,
          typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_relocate_launder(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
+{
+  using T = iterator_value_t<OutputIt>;
+  if constexpr (std::is_same_v<iterator_value_t<InputIt>, T> and
+                is_memcpy_relocatable_v<T, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memcpy_range(src, src_end, dst);
+    }
+  }
+  auto dst_end = uninitialized_move_if_noexcept_launder(src, src_end, dst, alloc);
+  destroy_launder(src, src_end, alloc);
+  return dst_end;
+}
+
+template<std::input_iterator InputIt, std::input_or_output_iterator OutputIt>
+constexpr //
+  OutputIt
+  copy_launder(InputIt src, InputIt src_end, OutputIt dst)
+{
+  if constexpr (detail::is_bytewise_copy_v<InputIt, OutputIt, void>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memmove_range(src, src_end, dst);
+    }
+  }
+  for (; src != src_end; ++src, ++dst) {
+    *maybe_launder(dst) = *maybe_launder(src);
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt, std::input_or_output_iterator OutputIt>
+constexpr //
+  OutputIt
+  move_if_noexcept_launder(InputIt src, InputIt src_end, OutputIt dst)
+{
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, void>) {
+    if (not std::is_constant_evaluated()) {
+      return detail::memmove_range(src, src_end, dst);
+    }
+  }
+  for (; src != src_end; ++src, ++dst) {
+    *maybe_launder(dst) = std::move_if_noexcept(*maybe_launder(src));
+  }
+  return dst;
+}
+
+template<std::bidirectional_iterator InputIt, std::bidirectional_iterator OutputIt>
 constexpr //
   OutputIt
   move_if_noexcept_launder_backward(InputIt src, InputIt src_end, OutputIt dst_end)
 {
-  for (; src != src_end; --src_end, --dst_end) {
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, void>) {
+    if (not std::is_constant_evaluated()) {
+      auto dst = dst_end - (src_end - src);
+      detail::memmove_range(src, src_end, dst);
+      return dst;
+    }
+  }
+  while (src != src_end) {
     --src_end;
     --dst_end;
-    *dst_end = std::move_if_noexcept(*std::launder(src_end));
+    *maybe_launder(dst_end) = std::move_if_noexcept(*maybe_launder(src_end));
   }
   return dst_end;
 }
 
-template<std::input_iterator InputIt,
-         std::input_or_output_iterator OutputIt,
+template<std::bidirectional_iterator InputIt,
+         std::bidirectional_iterator OutputIt,
          typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
 constexpr //
   OutputIt
@@ -185,13 +709,319 @@ constexpr //
                                                   OutputIt dst_end,
                                                   Allocator alloc)
 {
-  for (; src != src_end; --src_end, --dst_end) {
-    --src_end;
-    --dst_end;
-    std::allocator_traits<Allocator>::construct(
-      alloc, dst_end, std::move_if_noexcept(*std::launder(src_end)));
+  if constexpr (detail::is_bytewise_move_v<InputIt, OutputIt, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      auto dst = dst_end - (src_end - src);
+      detail::memmove_range(src, src_end, dst);
+      return dst;
+    }
+  }
+  auto dst_last = dst_end;
+  try {
+    while (src != src_end) {
+      --src_end;
+      --dst_end;
+      std::allocator_traits<Allocator>::construct(
+        alloc, dst_end, std::move_if_noexcept(*maybe_launder(src_end)));
+    }
+  } catch (...) {
+    destroy_launder(dst_end + 1, dst_last, alloc);
+    throw;
   }
   return dst_end;
 }
 
+template<typename Ptr, typename U, typename Allocator>
+constexpr //
+  void
+  insert_one_in_place(Ptr pos, Ptr& end, U&& value, Allocator alloc)
+{
+  if (pos == end) {
+    std::allocator_traits<Allocator>::construct(
+      alloc, std::to_address(end), std::forward<U>(value));
+    ++end;
+    return;
+  }
+  auto old_end = end;
+  uninitialized_move_if_noexcept_launder_backward(end - 1, end, end + 1, alloc);
+  ++end;
+  move_if_noexcept_launder_backward(pos, old_end - 1, old_end);
+  *maybe_launder(pos) = std::forward<U>(value);
+}
+
+template<typename Ptr, typename T, typename Allocator>
+constexpr //
+  void
+  insert_fill_in_place(Ptr pos, Ptr& end, std::size_t count, const T& value, Allocator alloc)
+{
+  auto old_end = end;
+  if (static_cast<std::size_t>(end - pos) > count) {
+    // Shift elements back, then assign value over the old ones
+    uninitialized_move_if_noexcept_launder_backward(end - count, end, end + count, alloc);
+    end += count;
+    move_if_noexcept_launder_backward(pos, old_end - count, old_end);
+    std::fill(pos, pos + count, value);
+  } else {
+    // The new elements overhang the old end, so some of them are constructed instead
+    auto overhang = uninitialized_construct(end, pos + count, alloc, value);
+    try {
+      uninitialized_move_if_noexcept_launder(pos, end, overhang, alloc);
+    } catch (...) {
+      destroy_launder(end, overhang, alloc);
+      throw;
+    }
+    end += count;
+    std::fill(pos, old_end, value);
+  }
+}
+
+template<typename Ptr, std::input_iterator It, typename Allocator>
+constexpr //
+  void
+  insert_copy_in_place(Ptr pos, Ptr& end, It src, std::size_t count, Allocator alloc)
+{
+  auto old_end = end;
+  auto tail = static_cast<std::size_t>(end - pos);
+  if (tail > count) {
+    // Shift elements back, then assign the new elements over the old ones
+    uninitialized_move_if_noexcept_launder_backward(end - count, end, end + count, alloc);
+    end += count;
+    move_if_noexcept_launder_backward(pos, old_end - count, old_end);
+    for (std::size_t i = 0; i < count; ++i, ++src, ++pos) {
+      *maybe_launder(pos) = *src;
+    }
+  } else {
+    // The new elements overhang the old end, so some of them are constructed instead
+    auto mid = std::ranges::next(src, static_cast<std::iter_difference_t<It>>(tail));
+    auto last = std::ranges::next(mid, static_cast<std::iter_difference_t<It>>(count - tail));
+    auto overhang = uninitialized_copy(mid, last, end, alloc);
+    try {
+      uninitialized_move_if_noexcept_launder(pos, end, overhang, alloc);
+    } catch (...) {
+      destroy_launder(end, overhang, alloc);
+      throw;
+    }
+    end += count;
+    for (; src != mid; ++src, ++pos) {
+      *maybe_launder(pos) = *src;
+    }
+  }
+}
+
+template<typename Ptr, std::input_iterator It, typename Allocator>
+constexpr //
+  void
+  assign_in_place(Ptr first, Ptr& end, It src, std::size_t count, Allocator alloc)
+{
+  auto size = static_cast<std::size_t>(end - first);
+  if (count < size) {
+    destroy_launder(first + count, end, alloc);
+    end = first + count;
+  }
+  auto common = static_cast<std::iter_difference_t<It>>(std::min(count, size));
+  auto rest = static_cast<std::iter_difference_t<It>>(count) - common;
+  if constexpr (std::contiguous_iterator<It>) {
+    // Plain pointers, so that trivially copyable elements are copied with memmove
+    auto p = std::to_address(src);
+    copy_launder(p, p + common, first);
+    end = uninitialized_copy_launder(p + common, p + common + rest, end, alloc);
+  } else {
+    for (auto dst = first; dst != first + common; ++dst, ++src) {
+      *maybe_launder(dst) = *src;
+    }
+    for (; rest > 0; --rest, ++src) {
+      std::allocator_traits<Allocator>::construct(alloc, std::to_address(end), *src);
+      ++end;
+    }
+  }
+}
+
+template<typename Ptr, typename Allocator>
+constexpr //
+  void
+  erase_in_place(Ptr pos, Ptr pos_end, Ptr& end, Allocator alloc)
+{
+  if (pos != pos_end) {
+    auto new_end = move_if_noexcept_launder(pos_end, end, pos);
+    destroy_launder(new_end, end, alloc);
+    end = new_end;
+  }
+}
+
+namespace detail {
+
+// The predicate erase(c, value) erases with, which erase_if_in_place picks out to erase
+// arithmetic elements with simd::remove_equal instead
+template<typename U>
+struct equal_to_value
+{
+  const U& value;
+
+  template<typename T>
+  constexpr bool operator()(const T& elem) const
+  {
+    return elem == value;
+  }
+};
+
+template<typename Pred, typename T>
+inline constexpr bool is_equal_to_value_v = false;
+
+template<typename T>
+inline constexpr bool is_equal_to_value_v<equal_to_value<T>, T> = std::is_arithmetic_v<T>;
+
+// Calls c.erase_if(equal_to_value{ value }), with value converted to the element type T first when
+// every element compares equal to it exactly when it compares equal to T(value), e.g. for
+// erase(floats, 0.0) or erase(u32s, 0), so that the erase is picked out for simd::remove_equal.
+// That holds when T(value) converts back to value, as long as no two elements convert to the same
+// value of the type they're compared in, which rules out integers compared as floating point.
+template<typename T, typename Container, typename U>
+constexpr //
+  auto
+  erase_value(Container& c, const U& value)
+{
+  if constexpr (std::is_arithmetic_v<T> and std::is_arithmetic_v<U> and not std::is_same_v<T, U> and
+                not(std::is_integral_v<T> and std::is_floating_point_v<U>)) {
+    using C = std::common_type_t<T, U>;
+    const auto converted = static_cast<T>(value);
+    if constexpr (std::is_same_v<C, T>) {
+      // The comparison is done in T anyway
+      return c.erase_if(equal_to_value<T>{ converted });
+    } else {
+      if (C(converted) == C(value)) {
+        return c.erase_if(equal_to_value<T>{ converted });
+      }
+      return c.erase_if(equal_to_value<U>{ value });
+    }
+  } else {
+    return c.erase_if(equal_to_value<U>{ value });
+  }
+}
+
+// Runtime only, for memcpy relocatable elements.
+// Survivors are in first..dst, erased or relocated elements in dst..p.
+template<typename Ptr, typename Pred, typename Allocator>
+void
+relocating_erase_if(Ptr first, Ptr& end, Pred& pred, Allocator& alloc)
+{
+  using T = typename std::pointer_traits<Ptr>::element_type;
+  auto dst = first;
+  auto p = first;
+  try {
+    if constexpr (std::is_scalar_v<T>) {
+      // Stores every element instead of branching on pred, which mispredicts all the time when
+      // the erased elements are spread around
+      for (; p != end; ++p) {
+        auto keep = not pred(std::as_const(*p));
+        *dst = *p;
+        dst += keep;
+      }
+    } else {
+      for (; p != end; ++p) {
+        if (pred(std::as_const(*maybe_launder(p)))) {
+          std::allocator_traits<Allocator>::destroy(alloc, std::to_address(p));
+        } else {
+          if (dst != p) {
+            std::memcpy(static_cast<void*>(std::to_address(dst)),
+                        static_cast<const void*>(std::to_address(p)),
+                        sizeof(T));
+          }
+          ++dst;
+        }
+      }
+    }
+  } catch (...) {
+    end = memmove_range(p, end, dst);
+    throw;
+  }
+  end = dst;
+}
+
+} // namespace detail
+
+template<typename Ptr, typename Pred, typename Allocator>
+constexpr //
+  std::size_t
+  erase_if_in_place(Ptr first, Ptr& end, Pred& pred, Allocator alloc)
+{
+  using T = typename std::pointer_traits<Ptr>::element_type;
+  auto oldsize = static_cast<std::size_t>(end - first);
+  if constexpr (is_memcpy_relocatable_v<T, Allocator>) {
+    if (not std::is_constant_evaluated()) {
+      if constexpr (detail::is_equal_to_value_v<Pred, T>) {
+        end = first + simd::remove_equal(std::to_address(first), oldsize, pred.value);
+      } else {
+        detail::relocating_erase_if(first, end, pred, alloc);
+      }
+      return oldsize - static_cast<std::size_t>(end - first);
+    }
+  }
+  // Survivors are in first..dst, moved from or erased elements in dst..p
+  auto dst = first;
+  auto p = first;
+  try {
+    for (; p != end; ++p) {
+      if (not pred(std::as_const(*maybe_launder(p)))) {
+        if (dst != p) {
+          *maybe_launder(dst) = std::move(*maybe_launder(p));
+        }
+        ++dst;
+      }
+    }
+  } catch (...) {
+    erase_in_place(dst, p, end, alloc);
+    throw;
+  }
+  destroy_launder(dst, end, alloc);
+  end = dst;
+  return oldsize - static_cast<std::size_t>(end - first);
+}
+
+template<typename Ptr, typename Pred, typename Allocator>
+constexpr //
+  std::size_t
+  unordered_erase_if_in_place(Ptr first, Ptr& end, Pred& pred, Allocator alloc)
+{
+  auto oldsize = static_cast<std::size_t>(end - first);
+  auto p = first;
+  auto last = end;
+  auto replacing = false;
+  try {
+    while (true) {
+      while (p != last and not pred(std::as_const(*maybe_launder(p)))) {
+        ++p;
+      }
+      if (p == last) {
+        break;
+      }
+      // *p goes, look for a survivor at the back to replace it with
+      replacing = true;
+      do {
+        --last;
+      } while (last != p and pred(std::as_const(*maybe_launder(last))));
+      replacing = false;
+      if (last == p) {
+        break;
+      }
+      *maybe_launder(p) = std::move(*maybe_launder(last));
+      ++p;
+    }
+  } catch (...) {
+    // Everything after last was either erased or moved from. If pred threw on *last itself
+    // (while looking for a survivor), *last stays, and still replaces *p which has to go.
+    auto keep = replacing ? last + 1 : last;
+    destroy_launder(keep, end, alloc);
+    end = keep;
+    if (replacing) {
+      *maybe_launder(p) = std::move(*maybe_launder(last));
+      destroy_launder(last, end, alloc);
+      end = last;
+    }
+    throw;
+  }
+  destroy_launder(last, end, alloc);
+  end = last;
+  return oldsize - static_cast<std::size_t>(end - first);
+}
+
 } // namespace constexpr_containers
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace constexpr_containers {
+
+// Contains allocator utilities useful for container classes.
+//
+// Synopsis:
+//
+// allocation_result<Pointer, SizeType>
+//   Like C++23's std::allocation_result, a pointer to the allocation and how many elements fit
+// allocate_at_least(alloc, n)
+//   Like C++23's std::allocate_at_least, allocates room for at least n elements,
+//   and reports how many elements actually fit so that the caller can use the slack.
+//   Allocators opt in by providing an allocate_at_least(n) member returning {ptr, count}.
+//   Otherwise std::allocator_traits::allocate_at_least is used where the standard library has it,
+//   and allocate(n) where it doesn't.
+// try_expand(alloc, p, count, n)
+//   Tries to grow the allocation at p, currently holding count elements, in place to at least n.
+//   Returns how many elements now fit, or 0 if it couldn't (or n <= count).
+//   Allocators opt in by providing a try_expand(p, count, n) member with the same semantics,
+//   otherwise this always fails. After a successful expansion, the memory must be deallocated
+//   with the new count.
+// malloc_allocator<T>
+//   An allocator using malloc and free
+// size_class_bytes(bytes, page_size = 4096)
+//   bytes rounded up to the block size a typical malloc would hand out for it anyway:
+//   a power of two (at least 16) below page_size, whole pages from there on
+// size_class_allocator<T, Allocator = malloc_allocator<T>, PageSize = 4096>
+//   Rounds every request up with size_class_bytes before passing it on to Allocator, and reports
+//   the rounded count from allocate_at_least. The slack is part of what was asked for, so it's
+//   safe to use, unlike the slack malloc_usable_size reports.
+// mmap_allocator<T> (Linux only)
+//   Maps whole pages for every allocation, which is only worth it for big vectors. It reports
+//   every element the pages hold from allocate_at_least, and implements try_expand with mremap,
+//   which grows the mapping in place when the address space after it is free (and, unlike
+//   realloc, fails rather than moving it), so growing the vector at the end doesn't relocate
+//   anything.
+//
+// Memory obtained this way must be deallocated with a count between n and the returned count.
+
+template<typename Pointer, typename SizeType = std::size_t>
+struct allocation_result
+{
+  Pointer ptr;
+  SizeType count;
+};
+
+template<typename Allocator>
+[[nodiscard]] constexpr //
+  allocation_result<typename std::allocator_traits<Allocator>::pointer,
+                    typename std::allocator_traits<Allocator>::size_type>
+  allocate_at_least(Allocator& alloc, typename std::allocator_traits<Allocator>::size_type n)
+{
+  if constexpr (requires { alloc.allocate_at_least(n); }) {
+    auto [ptr, count] = alloc.allocate_at_least(n);
+    return { ptr, count };
+  } else {
+#if defined(__cpp_lib_allocate_at_least)
+    auto [ptr, count] = std::allocator_traits<Allocator>::allocate_at_least(alloc, n);
+    return { ptr, count };
+#else
+    return { std::allocator_traits<Allocator>::allocate(alloc, n), n };
+#endif
+  }
+}
+
+template<typename Allocator>
+[[nodiscard]] constexpr //
+  typename std::allocator_traits<Allocator>::size_type
+  try_expand(Allocator& alloc,
+             typename std::allocator_traits<Allocator>::pointer p,
+             typename std::allocator_traits<Allocator>::size_type count,
+             typename std::allocator_traits<Allocator>::size_type n)
+{
+  if constexpr (requires { alloc.try_expand(p, count, n); }) {
+    if (n > count) {
+      return alloc.try_expand(p, count, n);
+    }
+  }
+  return 0;
+}
+
+// During constant evaluation, where malloc isn't allowed, this behaves just like std::allocator.
+template<typename T>
+struct malloc_allocator
+{
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "malloc_allocator doesn't support over-aligned types");
+
+  constexpr malloc_allocator() noexcept = default;
+
+  template<typename U>
+  constexpr malloc_allocator(const malloc_allocator<U>& /*other*/) noexcept
+  {}
+
+  [[nodiscard]] constexpr //
+    T*
+    allocate(size_type n)
+  {
+    if (std::is_constant_evaluated()) {
+      return std::allocator<T>().allocate(n);
+    }
+    if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    // malloc(0) may return nullptr, which would look like a failure
+    auto p = std::malloc(std::max(n * sizeof(T), size_type(1)));
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  constexpr //
+    void
+    deallocate(T* p, size_type n) //
+    noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      std::allocator<T>().deallocate(p, n);
+    } else {
+      std::free(p);
+    }
+  }
+
+  [[nodiscard]] constexpr //
+    friend bool
+    operator==(const malloc_allocator& /*a*/, const malloc_allocator& /*b*/) //
+    noexcept
+  {
+    return true;
+  }
+};
+
+[[nodiscard]] constexpr //
+  std::size_t
+  size_class_bytes(std::size_t bytes, std::size_t page_size = 4096) //
+  noexcept
+{
+  if (bytes < page_size) {
+    // Small blocks come from power of two bins
+    auto rounded = std::size_t(16);
+    while (rounded < bytes) {
+      rounded *= 2;
+    }
+    return rounded;
+  }
+  // Large blocks are mapped in whole pages
+  auto rounded = bytes / page_size * page_size;
+  return rounded == bytes or rounded > std::numeric_limits<std::size_t>::max() - page_size
+           ? bytes
+           : rounded + page_size;
+}
+
+template<typename T, typename Allocator = malloc_allocator<T>, std::size_t PageSize = 4096>
+struct size_class_allocator
+{
+private:
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  template<typename, typename, std::size_t>
+  friend struct size_class_allocator;
+
+  [[no_unique_address]] Allocator m_alloc;
+
+public:
+  using value_type = T;
+  using size_type = typename AllocTraitsT::size_type;
+  using difference_type = typename AllocTraitsT::difference_type;
+  using propagate_on_container_copy_assignment =
+    typename AllocTraitsT::propagate_on_container_copy_assignment;
+  using propagate_on_container_move_assignment =
+    typename AllocTraitsT::propagate_on_container_move_assignment;
+  using propagate_on_container_swap = typename AllocTraitsT::propagate_on_container_swap;
+  using is_always_equal = typename AllocTraitsT::is_always_equal;
+
+  template<typename U>
+  struct rebind
+  {
+    using other =
+      size_class_allocator<U, typename AllocTraitsT::template rebind_alloc<U>, PageSize>;
+  };
+
+  constexpr size_class_allocator() noexcept(noexcept(Allocator())) = default;
+
+  constexpr explicit size_class_allocator(const Allocator& alloc) noexcept
+    : m_alloc(alloc)
+  {}
+
+  template<typename U, typename OtherAllocator>
+  constexpr size_class_allocator(
+    const size_class_allocator<U, OtherAllocator, PageSize>& other) noexcept
+    : m_alloc(other.m_alloc)
+  {}
+
+  [[nodiscard]] constexpr //
+    allocation_result<typename AllocTraitsT::pointer, size_type>
+    allocate_at_least(size_type n)
+  {
+    auto count = rounded(n);
+    return { AllocTraitsT::allocate(m_alloc, count), count };
+  }
+
+  [[nodiscard]] constexpr //
+    typename AllocTraitsT::pointer
+    allocate(size_type n)
+  {
+    return allocate_at_least(n).ptr;
+  }
+
+  // Any n between the one asked for and the one returned rounds to the same count
+  constexpr //
+    void
+    deallocate(typename AllocTraitsT::pointer p, size_type n) //
+    noexcept
+  {
+    AllocTraitsT::deallocate(m_alloc, p, rounded(n));
+  }
+
+  [[nodiscard]] constexpr //
+    friend bool
+    operator==(const size_class_allocator& a, const size_class_allocator& b) //
+    noexcept
+  {
+    return a.m_alloc == b.m_alloc;
+  }
+
+private:
+  [[nodiscard]] static constexpr //
+    size_type
+    rounded(size_type n) //
+    noexcept
+  {
+    if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+      // Too big to round, let Allocator fail on it
+      return n;
+    }
+    return std::max(n, size_type(size_class_bytes(n * sizeof(T), PageSize) / sizeof(T)));
+  }
+};
+
+#if defined(__linux__)
+
+// During constant evaluation, where mmap isn't allowed, this behaves just like std::allocator.
+template<typename T>
+struct mmap_allocator
+{
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= 4096, "mmap_allocator doesn't support types aligned past a page");
+
+  constexpr mmap_allocator() noexcept = default;
+
+  template<typename U>
+  constexpr mmap_allocator(const mmap_allocator<U>& /*other*/) noexcept
+  {}
+
+  [[nodiscard]] constexpr //
+    allocation_result<T*, size_type>
+    allocate_at_least(size_type n)
+  {
+    if (std::is_constant_evaluated()) {
+      return { std::allocator<T>().allocate(n), n };
+    }
+    if (n > (std::numeric_limits<size_type>::max() - page_size()) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    auto bytes = mapped_bytes(n);
+    auto p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    return { static_cast<T*>(p), bytes / sizeof(T) };
+  }
+
+  [[nodiscard]] constexpr //
+    T*
+    allocate(size_type n)
+  {
+    return allocate_at_least(n).ptr;
+  }
+
+  // Without MREMAP_MAYMOVE, mremap either grows the mapping where it is or fails
+  [[nodiscard]] constexpr //
+    size_type
+    try_expand(T* p, size_type count, size_type n) //
+    noexcept
+  {
+    if (std::is_constant_evaluated() or
+        n > (std::numeric_limits<size_type>::max() - page_size()) / sizeof(T)) {
+      return 0;
+    }
+    auto bytes = mapped_bytes(n);
+    if (::mremap(p, mapped_bytes(count), bytes, 0) == MAP_FAILED) {
+      return 0;
+    }
+    return bytes / sizeof(T);
+  }
+
+  // Any n between the one asked for and the one returned maps to the same pages
+  constexpr //
+    void
+    deallocate(T* p, size_type n) //
+    noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      std::allocator<T>().deallocate(p, n);
+    } else {
+      ::munmap(p, mapped_bytes(n));
+    }
+  }
+
+  [[nodiscard]] constexpr //
+    friend bool
+    operator==(const mmap_allocator& /*a*/, const mmap_allocator& /*b*/) //
+    noexcept
+  {
+    return true;
+  }
+
+private:
+  [[nodiscard]] static //
+    size_type
+    page_size() //
+    noexcept
+  {
+    static const auto size = size_type(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  // n elements rounded up to whole pages, and at least one
+  [[nodiscard]] static //
+    size_type
+    mapped_bytes(size_type n) //
+    noexcept
+  {
+    auto pages = (std::max(n * sizeof(T), size_type(1)) + page_size() - 1) / page_size();
+    return pages * page_size();
+  }
+};
+
+#endif
+
+} // namespace constexpr_containers
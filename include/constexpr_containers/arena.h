@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+namespace constexpr_containers {
+
+// A monotonic arena, handing out memory from a caller supplied buffer by bumping a pointer.
+//
+// Synopsis:
+//
+// arena
+//   Owns nothing, just tracks how much of its buffer has been handed out.
+//   Memory is only given back all at once, by release() (or by throwing the buffer away).
+// arena_allocator<T>
+//   An allocator drawing from an arena. deallocate is a no-op, and the most recent allocation
+//   can be expanded in place (see try_expand in allocator.h), so a vector growing at the end of
+//   the arena never relocates its elements.
+//
+// Running out of buffer throws std::bad_alloc, there is no upstream allocator to fall back to.
+//
+// During constant evaluation the buffer can't be used (objects can only be constructed in storage
+// obtained from std::allocator), so arena_allocator behaves like std::allocator instead.
+//
+//   alignas(std::max_align_t) std::byte buffer[4096];
+//   arena scratch(buffer);
+//   vector<int, arena_allocator<int>> v(scratch);
+//   ...
+//   scratch.release(); // once nothing is using the arena anymore
+
+struct arena
+{
+private:
+  std::byte* m_begin;
+  std::byte* m_cur;
+  std::byte* m_end;
+
+public:
+  constexpr arena(std::byte* buffer, std::size_t size) noexcept
+    : m_begin(buffer)
+    , m_cur(buffer)
+    , m_end(buffer + size)
+  {}
+
+  constexpr explicit arena(std::span<std::byte> buffer) noexcept
+    : arena(buffer.data(), buffer.size())
+  {}
+
+  // Allocators point at their arena, so it can't be moved around
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  // Returns size bytes aligned to align, or nullptr if they don't fit
+  [[nodiscard]] void* allocate(std::size_t size, std::size_t align) noexcept
+  {
+    auto p = align_up(m_cur, align);
+    if (p > m_end or size > std::size_t(m_end - p)) {
+      return nullptr;
+    }
+    m_cur = p + size;
+    return p;
+  }
+
+  // Grows the allocation of old_size bytes at p to new_size bytes,
+  // which only works if nothing has been allocated since
+  [[nodiscard]] bool try_expand(void* p, std::size_t old_size, std::size_t new_size) noexcept
+  {
+    auto end = static_cast<std::byte*>(p) + old_size;
+    if (end != m_cur or new_size - old_size > std::size_t(m_end - m_cur)) {
+      return false;
+    }
+    m_cur = end + (new_size - old_size);
+    return true;
+  }
+
+  // Makes the whole buffer available again. Everything allocated from it must be dead by now.
+  constexpr void release() noexcept { m_cur = m_begin; }
+
+  [[nodiscard]] constexpr std::size_t used() const noexcept { return std::size_t(m_cur - m_begin); }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return std::size_t(m_end - m_begin); }
+
+private:
+  [[nodiscard]] static std::byte* align_up(std::byte* p, std::size_t align) noexcept
+  {
+    auto addr = reinterpret_cast<std::uintptr_t>(p);
+    return p + ((align - addr % align) % align);
+  }
+};
+
+template<typename T>
+struct arena_allocator
+{
+  template<typename>
+  friend struct arena_allocator;
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+private:
+  arena* m_arena;
+
+public:
+  // Not explicit, so containers can be constructed straight from an arena
+  constexpr arena_allocator(arena& a) noexcept
+    : m_arena(&a)
+  {}
+
+  template<typename U>
+  constexpr arena_allocator(const arena_allocator<U>& other) noexcept
+    : m_arena(other.m_arena)
+  {}
+
+  [[nodiscard]] constexpr //
+    T*
+    allocate(size_type n)
+  {
+    if (std::is_constant_evaluated()) {
+      return std::allocator<T>().allocate(n);
+    }
+    if (n > max_size()) {
+      throw std::bad_array_new_length();
+    }
+    auto p = m_arena->allocate(n * sizeof(T), alignof(T));
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  constexpr //
+    void
+    deallocate(T* p, size_type n) //
+    noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    try_expand(T* p, size_type count, size_type n) //
+    noexcept
+  {
+    if (std::is_constant_evaluated() or n > max_size()) {
+      return 0;
+    }
+    return m_arena->try_expand(p, count * sizeof(T), n * sizeof(T)) ? n : 0;
+  }
+
+  [[nodiscard]] static constexpr size_type max_size() noexcept { return size_type(-1) / sizeof(T); }
+
+  [[nodiscard]] constexpr arena& resource() const noexcept { return *m_arena; }
+
+  [[nodiscard]] constexpr //
+    friend bool
+    operator==(const arena_allocator& a, const arena_allocator& b) //
+    noexcept
+  {
+    return a.m_arena == b.m_arena;
+  }
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+#include "constexpr_containers/vector.h"
+
+namespace constexpr_containers {
+
+// Static search indexes over a sorted range, for when a big sorted vector is searched far more
+// often than it changes.
+//
+// A binary search over n elements touches log2(n) cache lines, each depending on the last, and
+// once the vector is bigger than the cache nearly every one of them is a miss. These indexes copy
+// the elements into a layout where the elements compared in a row sit next to each other:
+//
+// - eytzinger_index stores them in the order of a breadth first walk of the binary search tree,
+//   so that the children of element k are 2k and 2k + 1. All the descendants of k four levels down
+//   (for 4 byte elements) then share a single cache line, which is fetched while the next four
+//   comparisons are done. It's the same number of comparisons, but without waiting on memory.
+// - btree_index is an implicit B+ tree whose nodes are single cache lines of B keys, and whose
+//   leaves are the elements in order. Each level narrows the search down by a factor of B + 1
+//   rather than 2, so there are about log2(B + 1) times fewer dependent misses.
+//
+// Both are built in O(n) by their constexpr constructor, and take no more memory than the
+// elements do plus a cache line (for btree_index, about 1/B more for the inner nodes).
+//
+// Synopsis:
+//
+// eytzinger_index<T, Compare = std::less<T>>
+// btree_index<T, Compare = std::less<T>>
+//   Built from a sorted random access range, e.g. a vector. T has to be default constructible
+//   and copyable.
+//   lower_bound(value) and upper_bound(value) return the position of the first element which is
+//   not less than (greater than) value in the sorted range, or size() if there's none, so that
+//   they can index the range the index was built from, or any vector parallel to it.
+//   contains(value) is whether an element is equivalent to value.
+
+namespace detail {
+
+// The number of elements per cache line, rounded down to a power of two so that lines hold
+// whole levels of a subtree
+template<typename T>
+inline constexpr std::size_t line_elements =
+  std::bit_floor(std::max(std::size_t(64) / sizeof(T), std::size_t(1)));
+
+template<typename T>
+struct alignas(std::max(std::size_t(64), alignof(T))) cache_line
+{
+  std::array<T, line_elements<T>> values{};
+};
+
+// Does nothing during constant evaluation, or on compilers without the builtin
+constexpr void
+prefetch(const void* p) noexcept
+{
+  if (not std::is_constant_evaluated()) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+  }
+}
+
+} // namespace detail
+
+template<std::default_initializable T, typename Compare = std::less<T>>
+class eytzinger_index
+{
+public:
+  //////////////////
+  // Member types //
+  //////////////////
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using value_compare = Compare;
+
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr eytzinger_index() = default;
+
+  template<std::ranges::random_access_range Range>
+  constexpr explicit eytzinger_index(const Range& sorted, const Compare& comp = Compare())
+    : m_size(size_type(std::ranges::size(sorted)))
+    , m_lines((m_size + line) / line)
+    , m_comp(comp)
+  {
+    // An in-order walk of the tree visits the elements in sorted order
+    auto k = leftmost(1);
+    for (const auto& elem : sorted) {
+      node(k) = elem;
+      k = 2 * k + 1 <= m_size ? leftmost(2 * k + 1) : k >> (std::countr_one(k) + 1);
+    }
+  }
+
+  //////////////
+  // Capacity //
+  //////////////
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+
+  ////////////
+  // Lookup //
+  ////////////
+
+  [[nodiscard]] constexpr //
+    size_type
+    lower_bound(const T& value) const
+  {
+    return rank(search([&](const T& elem) { return bool(m_comp(elem, value)); }));
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    upper_bound(const T& value) const
+  {
+    return rank(search([&](const T& elem) { return not m_comp(value, elem); }));
+  }
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(const T& value) const
+  {
+    auto k = search([&](const T& elem) { return bool(m_comp(elem, value)); });
+    return k != 0 and not m_comp(value, node(k));
+  }
+
+private:
+  static constexpr size_type line = detail::line_elements<T>;
+
+  // Element k lives at index k, and index 0 is unused
+  [[nodiscard]] constexpr T& node(size_type k) { return m_lines[k / line].values[k % line]; }
+
+  [[nodiscard]] constexpr //
+    const T&
+    node(size_type k) const
+  {
+    return m_lines[k / line].values[k % line];
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    leftmost(size_type k) const noexcept
+  {
+    while (2 * k <= m_size) {
+      k *= 2;
+    }
+    return k;
+  }
+
+  // The first node in sorted order for which pred is false, or 0 if there's none.
+  // The path taken is the bits of k, with a 1 for each step right (pred true). After falling off
+  // the tree, dropping the trailing right steps and the last left step gives the node where we
+  // last went left.
+  template<typename Pred>
+  [[nodiscard]] constexpr //
+    size_type
+    search(Pred pred) const
+  {
+    auto k = size_type(1);
+    while (k <= m_size) {
+      // The descendants of k, log2(line) levels down, are exactly line k
+      detail::prefetch(&m_lines[std::min(k, m_lines.size() - 1)]);
+      k = 2 * k + size_type(pred(node(k)));
+    }
+    return k >> (std::countr_one(k) + 1);
+  }
+
+  // The position of node k in sorted order. In a perfect tree of height h, the node at depth d
+  // comes after (2 * (k - 2^d) + 1) * 2^(h - 1 - d) - 1 nodes. Here the bottom level can be
+  // incomplete, and the missing leaves (those past m_size) are the last of that level.
+  [[nodiscard]] constexpr //
+    size_type
+    rank(size_type k) const noexcept
+  {
+    if (k == 0) {
+      return m_size;
+    }
+    auto height = std::bit_width(m_size);
+    auto depth = std::bit_width(k) - 1;
+    auto level = size_type(1) << depth;
+    auto r = ((2 * (k - level) + 1) << (height - 1 - depth)) - 1;
+    // The missing leaf j (in the perfect tree) comes after 2 * (j - bottom) nodes
+    auto bottom = size_type(1) << (height - 1);
+    auto missing = bottom + (r + 1) / 2;
+    return missing > m_size + 1 ? r - (missing - m_size - 1) : r;
+  }
+
+  size_type m_size = 0;
+  vector<detail::cache_line<T>> m_lines;
+  [[no_unique_address]] Compare m_comp;
+};
+
+template<std::default_initializable T, typename Compare = std::less<T>>
+class btree_index
+{
+public:
+  //////////////////
+  // Member types //
+  //////////////////
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using value_compare = Compare;
+
+  // Keys per node. A node has B + 1 children, and key i is the largest key under child i.
+  static constexpr size_type B = detail::line_elements<T>;
+
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr btree_index() = default;
+
+  template<std::ranges::random_access_range Range>
+  constexpr explicit btree_index(const Range& sorted, const Compare& comp = Compare())
+    : m_size(size_type(std::ranges::size(sorted)))
+    , m_comp(comp)
+  {
+    if (m_size == 0) {
+      return;
+    }
+    // Level 0 is the leaves, and each level above has a node per B + 1 nodes below it
+    auto sizes = vector<size_type>{ (m_size + B - 1) / B };
+    while (sizes.back() > 1) {
+      sizes.push_back((sizes.back() + B) / (B + 1));
+    }
+    m_offsets.reserve(sizes.size());
+    auto total = size_type(0);
+    for (auto size : sizes) {
+      m_offsets.push_back(total);
+      total += size;
+    }
+    m_nodes.resize(total);
+
+    // Everything past the end is padded with the last element, which keeps the keys sorted
+    auto first = std::ranges::begin(sorted);
+    auto at = [&](size_type i) -> decltype(auto) { return first[std::min(i, m_size) - 1]; };
+    for (size_type i = 0; i < sizes[0] * B; ++i) {
+      m_nodes[i / B].values[i % B] = at(i + 1);
+    }
+    // A node at level h covers (B + 1)^h leaves
+    auto span = size_type(1);
+    for (size_type h = 1; h < sizes.size(); ++h) {
+      for (size_type k = 0; k < sizes[h]; ++k) {
+        for (size_type i = 0; i < B; ++i) {
+          auto child = k * (B + 1) + i;
+          m_nodes[m_offsets[h] + k].values[i] = at((child + 1) * span * B);
+        }
+      }
+      span *= B + 1;
+    }
+  }
+
+  //////////////
+  // Capacity //
+  //////////////
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+
+  ////////////
+  // Lookup //
+  ////////////
+
+  [[nodiscard]] constexpr //
+    size_type
+    lower_bound(const T& value) const
+  {
+    return search([&](const T& elem) { return bool(m_comp(elem, value)); });
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    upper_bound(const T& value) const
+  {
+    return search([&](const T& elem) { return not m_comp(value, elem); });
+  }
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(const T& value) const
+  {
+    auto i = lower_bound(value);
+    return i != m_size and not m_comp(value, leaf(i));
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    const T&
+    leaf(size_type i) const
+  {
+    return m_nodes[i / B].values[i % B];
+  }
+
+  // How many keys of the node pred is true for, without branching on each
+  template<typename Pred>
+  [[nodiscard]] static constexpr //
+    size_type
+    count(const detail::cache_line<T>& node, Pred& pred)
+  {
+    auto n = size_type(0);
+    for (const auto& key : node.values) {
+      n += size_type(pred(key));
+    }
+    return n;
+  }
+
+  // The number of elements pred is true for, which have to come first. The last element is
+  // checked up front, so that the answer is always under the child picked at each level (as
+  // its largest key is one pred is false for), and never in the padding.
+  template<typename Pred>
+  [[nodiscard]] constexpr //
+    size_type
+    search(Pred pred) const
+  {
+    if (m_size == 0 or pred(leaf(m_size - 1))) {
+      return m_size;
+    }
+    auto k = size_type(0);
+    for (auto h = m_offsets.size() - 1; h > 0; --h) {
+      k = k * (B + 1) + count(m_nodes[m_offsets[h] + k], pred);
+    }
+    return k * B + count(m_nodes[k], pred);
+  }
+
+  size_type m_size = 0;
+  vector<detail::cache_line<T>> m_nodes;
+  vector<size_type> m_offsets;
+  [[no_unique_address]] Compare m_comp;
+};
+
+} // namespace constexpr_containers
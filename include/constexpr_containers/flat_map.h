@@ -0,0 +1,889 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/flat_set.h"
+#include "constexpr_containers/vector.h"
+
+namespace constexpr_containers {
+
+// A sorted map kept in two vectors, one of keys and one of values, like C++23's std::flat_map.
+// Lookups only ever touch the keys, which are packed together, so a binary search pulls in far
+// fewer cache lines than it would with the values interleaved (or than a std::map would).
+// Everything is constexpr, as long as the containers are.
+//
+// Synopsis:
+//
+// flat_map<Key, T, Compare = std::less<Key>, KeyContainer = vector<Key>,
+//          MappedContainer = vector<T>>
+//   The interface of std::flat_map: operator[], at, insert, insert_or_assign, try_emplace,
+//   emplace, erase, find, contains, count, lower_bound, upper_bound, equal_range (and the
+//   heterogeneous versions when Compare::is_transparent), keys() and values() to get at either
+//   container, extract() and replace(keys, values) to take both out or put them in, == and <=>.
+//   Constructors and insert take sorted_unique (see flat_set.h), and insert ranges the same way
+//   flat_set does: the new elements are sorted on their own and then merged in.
+//   Of equivalent keys, the element already in the map wins, and then the one which came first.
+//   Iterators dereference to a pair<const Key&, T&> (a proxy, like std::flat_map's), so they are
+//   random access in everything but name: iterator_category is random_access_iterator_tag,
+//   but they don't model std::random_access_iterator.
+
+namespace detail {
+
+template<typename KeyIt, typename MappedIt>
+class flat_map_iterator
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::pair<iterator_value_t<KeyIt>, iterator_value_t<MappedIt>>;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::pair<std::iter_reference_t<KeyIt>, std::iter_reference_t<MappedIt>>;
+
+  // operator-> has to return something with an operator-> of its own
+  struct pointer
+  {
+    reference ref;
+
+    constexpr reference* operator->() noexcept { return std::addressof(ref); }
+  };
+
+  constexpr flat_map_iterator() = default;
+  constexpr flat_map_iterator(KeyIt key, MappedIt mapped)
+    : m_key(key)
+    , m_mapped(mapped)
+  {}
+  // iterator to const_iterator
+  template<typename MappedIt2>
+    requires(not std::is_same_v<MappedIt, MappedIt2> and std::is_convertible_v<MappedIt2, MappedIt>)
+  constexpr flat_map_iterator(const flat_map_iterator<KeyIt, MappedIt2>& other)
+    : m_key(other.key_iterator())
+    , m_mapped(other.mapped_iterator())
+  {}
+
+  [[nodiscard]] constexpr KeyIt key_iterator() const { return m_key; }
+  [[nodiscard]] constexpr MappedIt mapped_iterator() const { return m_mapped; }
+
+  [[nodiscard]] constexpr reference operator*() const { return { *m_key, *m_mapped }; }
+  [[nodiscard]] constexpr pointer operator->() const { return { **this }; }
+  [[nodiscard]] constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+  constexpr flat_map_iterator& operator++()
+  {
+    ++m_key;
+    ++m_mapped;
+    return *this;
+  }
+  constexpr flat_map_iterator& operator--()
+  {
+    --m_key;
+    --m_mapped;
+    return *this;
+  }
+  constexpr flat_map_iterator operator++(int)
+  {
+    auto old = *this;
+    ++*this;
+    return old;
+  }
+  constexpr flat_map_iterator operator--(int)
+  {
+    auto old = *this;
+    --*this;
+    return old;
+  }
+
+  constexpr flat_map_iterator& operator+=(difference_type n)
+  {
+    m_key += n;
+    m_mapped += n;
+    return *this;
+  }
+  constexpr flat_map_iterator& operator-=(difference_type n)
+  {
+    m_key -= n;
+    m_mapped -= n;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr //
+    flat_map_iterator
+    operator+(flat_map_iterator it, difference_type n)
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr //
+    flat_map_iterator
+    operator+(difference_type n, flat_map_iterator it)
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr //
+    flat_map_iterator
+    operator-(flat_map_iterator it, difference_type n)
+  {
+    return it -= n;
+  }
+  [[nodiscard]] friend constexpr //
+    difference_type
+    operator-(const flat_map_iterator& a, const flat_map_iterator& b)
+  {
+    return a.m_key - b.m_key;
+  }
+
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const flat_map_iterator& a, const flat_map_iterator& b)
+  {
+    return a.m_key == b.m_key;
+  }
+  [[nodiscard]] friend constexpr //
+    auto
+    operator<=>(const flat_map_iterator& a, const flat_map_iterator& b)
+  {
+    return a.m_key <=> b.m_key;
+  }
+
+private:
+  KeyIt m_key{};
+  MappedIt m_mapped{};
+};
+
+} // namespace detail
+
+template<typename Key,
+         typename T,
+         typename Compare = std::less<Key>,
+         typename KeyContainer = vector<Key>,
+         typename MappedContainer = vector<T>>
+class flat_map
+{
+public:
+  //////////////////
+  // Member types //
+  //////////////////
+
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = std::pair<const key_type&, mapped_type&>;
+  using const_reference = std::pair<const key_type&, const mapped_type&>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::flat_map_iterator<typename KeyContainer::const_iterator,
+                                             typename MappedContainer::iterator>;
+  using const_iterator = detail::flat_map_iterator<typename KeyContainer::const_iterator,
+                                                   typename MappedContainer::const_iterator>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using key_container_type = KeyContainer;
+  using mapped_container_type = MappedContainer;
+
+  class value_compare
+  {
+  public:
+    [[nodiscard]] constexpr //
+      bool
+      operator()(const_reference a, const_reference b) const
+    {
+      return m_comp(a.first, b.first);
+    }
+
+  private:
+    friend flat_map;
+    constexpr explicit value_compare(key_compare comp)
+      : m_comp(comp)
+    {}
+
+    [[no_unique_address]] key_compare m_comp;
+  };
+
+  struct containers
+  {
+    key_container_type keys;
+    mapped_container_type values;
+  };
+
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr flat_map() = default;
+  constexpr explicit flat_map(const key_compare& comp)
+    : m_keys()
+    , m_values()
+    , m_comp(comp)
+  {}
+  // keys and values have to be the same size
+  constexpr flat_map(key_container_type keys,
+                     mapped_container_type values,
+                     const key_compare& comp = key_compare())
+    : m_keys(std::move(keys))
+    , m_values(std::move(values))
+    , m_comp(comp)
+  {
+    sort_unique(0);
+  }
+  constexpr flat_map(sorted_unique_t,
+                     key_container_type keys,
+                     mapped_container_type values,
+                     const key_compare& comp = key_compare())
+    : m_keys(std::move(keys))
+    , m_values(std::move(values))
+    , m_comp(comp)
+  {}
+  template<std::input_iterator InputIt>
+  constexpr flat_map(InputIt first, InputIt last, const key_compare& comp = key_compare())
+    : m_keys()
+    , m_values()
+    , m_comp(comp)
+  {
+    insert(first, last);
+  }
+  template<std::input_iterator InputIt>
+  constexpr flat_map(sorted_unique_t,
+                     InputIt first,
+                     InputIt last,
+                     const key_compare& comp = key_compare())
+    : m_keys()
+    , m_values()
+    , m_comp(comp)
+  {
+    append(first, last);
+  }
+  constexpr flat_map(std::initializer_list<value_type> il, const key_compare& comp = key_compare())
+    : flat_map(il.begin(), il.end(), comp)
+  {}
+  constexpr flat_map(sorted_unique_t,
+                     std::initializer_list<value_type> il,
+                     const key_compare& comp = key_compare())
+    : flat_map(sorted_unique, il.begin(), il.end(), comp)
+  {}
+
+  constexpr flat_map& operator=(std::initializer_list<value_type> il)
+  {
+    clear();
+    insert(il);
+    return *this;
+  }
+
+  ///////////////
+  // Iterators //
+  ///////////////
+
+  [[nodiscard]] constexpr //
+    iterator
+    begin() //
+    noexcept
+  {
+    return { m_keys.cbegin(), m_values.begin() };
+  }
+  [[nodiscard]] constexpr //
+    iterator
+    end() //
+    noexcept
+  {
+    return { m_keys.cend(), m_values.end() };
+  }
+  [[nodiscard]] constexpr //
+    const_iterator
+    begin() //
+    const noexcept
+  {
+    return { m_keys.begin(), m_values.begin() };
+  }
+  [[nodiscard]] constexpr //
+    const_iterator
+    end() //
+    const noexcept
+  {
+    return { m_keys.end(), m_values.end() };
+  }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+  [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  [[nodiscard]] constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  [[nodiscard]] constexpr //
+    const_reverse_iterator
+    rbegin() //
+    const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+  [[nodiscard]] constexpr //
+    const_reverse_iterator
+    rend() //
+    const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+  [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+  //////////////
+  // Capacity //
+  //////////////
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return m_keys.empty(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return m_keys.size(); }
+  [[nodiscard]] constexpr //
+    size_type
+    max_size() //
+    const noexcept
+  {
+    return std::min<size_type>(m_keys.max_size(), m_values.max_size());
+  }
+
+  ////////////////////
+  // Element access //
+  ////////////////////
+
+  constexpr mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
+  constexpr //
+    mapped_type&
+    operator[](key_type&& key)
+  {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  [[nodiscard]] constexpr //
+    mapped_type&
+    at(const key_type& key)
+  {
+    return m_values[index_of_existing(key)];
+  }
+  [[nodiscard]] constexpr //
+    const mapped_type&
+    at(const key_type& key) const
+  {
+    return m_values[index_of_existing(key)];
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename... Args>
+  constexpr //
+    std::pair<iterator, bool>
+    emplace(Args&&... args)
+  {
+    auto value = value_type(std::forward<Args>(args)...);
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+  template<typename... Args>
+  constexpr //
+    iterator
+    emplace_hint(const_iterator, Args&&... args)
+  {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  constexpr //
+    std::pair<iterator, bool>
+    insert(const value_type& value)
+  {
+    return try_emplace(value.first, value.second);
+  }
+  constexpr //
+    std::pair<iterator, bool>
+    insert(value_type&& value)
+  {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+  constexpr //
+    iterator
+    insert(const_iterator, const value_type& value)
+  {
+    return insert(value).first;
+  }
+  constexpr //
+    iterator
+    insert(const_iterator, value_type&& value)
+  {
+    return insert(std::move(value)).first;
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    insert(InputIt first, InputIt last)
+  {
+    auto sorted = size();
+    append(first, last);
+    sort_unique(sorted);
+  }
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    insert(sorted_unique_t, InputIt first, InputIt last)
+  {
+    auto sorted = size();
+    append(first, last);
+    auto order = vector<size_type>(size() - sorted);
+    std::iota(order.begin(), order.end(), size_type(0));
+    merge_unique(sorted, order);
+  }
+  constexpr void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+  constexpr //
+    void
+    insert(sorted_unique_t, std::initializer_list<value_type> il)
+  {
+    insert(sorted_unique, il.begin(), il.end());
+  }
+
+  template<typename... Args>
+  constexpr //
+    std::pair<iterator, bool>
+    try_emplace(const key_type& key, Args&&... args)
+  {
+    return try_emplace_unique(key, std::forward<Args>(args)...);
+  }
+  template<typename... Args>
+  constexpr //
+    std::pair<iterator, bool>
+    try_emplace(key_type&& key, Args&&... args)
+  {
+    return try_emplace_unique(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template<typename M>
+  constexpr //
+    std::pair<iterator, bool>
+    insert_or_assign(const key_type& key, M&& obj)
+  {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (not result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+  template<typename M>
+  constexpr //
+    std::pair<iterator, bool>
+    insert_or_assign(key_type&& key, M&& obj)
+  {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (not result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr //
+    containers
+    extract() &&
+  {
+    return { std::move(m_keys), std::move(m_values) };
+  }
+  // keys has to be sorted and free of duplicates, and the same size as values
+  constexpr //
+    void
+    replace(key_container_type&& keys, mapped_container_type&& values)
+  {
+    m_keys = std::move(keys);
+    m_values = std::move(values);
+  }
+
+  constexpr iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+  constexpr //
+    iterator
+    erase(const_iterator pos)
+  {
+    return erase(pos, std::next(pos));
+  }
+  constexpr //
+    iterator
+    erase(const_iterator first, const_iterator last)
+  {
+    auto key = m_keys.erase(first.key_iterator(), last.key_iterator());
+    auto mapped = m_values.erase(first.mapped_iterator(), last.mapped_iterator());
+    return { key, mapped };
+  }
+  constexpr //
+    size_type
+    erase(const key_type& key)
+  {
+    return erase_equal(key);
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  constexpr //
+    size_type
+    erase(const K& key)
+  {
+    return erase_equal(key);
+  }
+
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    m_keys.clear();
+    m_values.clear();
+  }
+
+  constexpr //
+    void
+    swap(flat_map& other) //
+    noexcept(std::is_nothrow_swappable_v<key_container_type> and
+             std::is_nothrow_swappable_v<mapped_container_type> and
+             std::is_nothrow_swappable_v<key_compare>)
+  {
+    using std::swap;
+    swap(m_keys, other.m_keys);
+    swap(m_values, other.m_values);
+    swap(m_comp, other.m_comp);
+  }
+
+  friend constexpr //
+    void
+    swap(flat_map& a, flat_map& b) //
+    noexcept(noexcept(a.swap(b)))
+  {
+    a.swap(b);
+  }
+
+  ///////////////
+  // Observers //
+  ///////////////
+
+  [[nodiscard]] constexpr key_compare key_comp() const { return m_comp; }
+  [[nodiscard]] constexpr value_compare value_comp() const { return value_compare(m_comp); }
+  [[nodiscard]] constexpr const key_container_type& keys() const noexcept { return m_keys; }
+  [[nodiscard]] constexpr const mapped_container_type& values() const noexcept { return m_values; }
+
+  ////////////
+  // Lookup //
+  ////////////
+
+  [[nodiscard]] constexpr iterator find(const key_type& key) { return at_index(find_index(key)); }
+  [[nodiscard]] constexpr //
+    const_iterator
+    find(const key_type& key) const
+  {
+    return at_index(find_index(key));
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    iterator
+    find(const K& key)
+  {
+    return at_index(find_index(key));
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    const_iterator
+    find(const K& key) const
+  {
+    return at_index(find_index(key));
+  }
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(const key_type& key) const
+  {
+    return find_index(key) != size();
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    bool
+    contains(const K& key) const
+  {
+    return find_index(key) != size();
+  }
+
+  [[nodiscard]] constexpr size_type count(const key_type& key) const { return contains(key); }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    size_type
+    count(const K& key) const
+  {
+    return contains(key);
+  }
+
+  [[nodiscard]] constexpr //
+    iterator
+    lower_bound(const key_type& key)
+  {
+    return at_index(lower_bound_index(key));
+  }
+  [[nodiscard]] constexpr //
+    const_iterator
+    lower_bound(const key_type& key) const
+  {
+    return at_index(lower_bound_index(key));
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    iterator
+    lower_bound(const K& key)
+  {
+    return at_index(lower_bound_index(key));
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    const_iterator
+    lower_bound(const K& key) const
+  {
+    return at_index(lower_bound_index(key));
+  }
+
+  [[nodiscard]] constexpr //
+    iterator
+    upper_bound(const key_type& key)
+  {
+    return at_index(upper_bound_index(key));
+  }
+  [[nodiscard]] constexpr //
+    const_iterator
+    upper_bound(const key_type& key) const
+  {
+    return at_index(upper_bound_index(key));
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    iterator
+    upper_bound(const K& key)
+  {
+    return at_index(upper_bound_index(key));
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    const_iterator
+    upper_bound(const K& key) const
+  {
+    return at_index(upper_bound_index(key));
+  }
+
+  [[nodiscard]] constexpr //
+    std::pair<iterator, iterator>
+    equal_range(const key_type& key)
+  {
+    return { lower_bound(key), upper_bound(key) };
+  }
+  [[nodiscard]] constexpr //
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const
+  {
+    return { lower_bound(key), upper_bound(key) };
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    std::pair<iterator, iterator>
+    equal_range(const K& key)
+  {
+    return { lower_bound(key), upper_bound(key) };
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    std::pair<const_iterator, const_iterator>
+    equal_range(const K& key) const
+  {
+    return { lower_bound(key), upper_bound(key) };
+  }
+
+  //////////////////////////
+  // Comparison operators //
+  //////////////////////////
+
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const flat_map& a, const flat_map& b)
+  {
+    return a.m_keys == b.m_keys and a.m_values == b.m_values;
+  }
+
+  [[nodiscard]] friend constexpr //
+    auto
+    operator<=>(const flat_map& a, const flat_map& b)
+  {
+    return std::lexicographical_compare_three_way(
+      a.begin(), a.end(), b.begin(), b.end(), [](const_reference x, const_reference y) {
+        return x <=> y;
+      });
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    iterator
+    at_index(size_type i)
+  {
+    return begin() + difference_type(i);
+  }
+  [[nodiscard]] constexpr //
+    const_iterator
+    at_index(size_type i) const
+  {
+    return begin() + difference_type(i);
+  }
+
+  template<typename K>
+  [[nodiscard]] constexpr //
+    size_type
+    lower_bound_index(const K& key) const
+  {
+    return size_type(branchless_lower_bound(m_keys.begin(), m_keys.end(), key, m_comp) -
+                     m_keys.begin());
+  }
+
+  template<typename K>
+  [[nodiscard]] constexpr //
+    size_type
+    upper_bound_index(const K& key) const
+  {
+    return size_type(branchless_upper_bound(m_keys.begin(), m_keys.end(), key, m_comp) -
+                     m_keys.begin());
+  }
+
+  // size() if there's no such key
+  template<typename K>
+  [[nodiscard]] constexpr //
+    size_type
+    find_index(const K& key) const
+  {
+    auto i = lower_bound_index(key);
+    return i != size() and not m_comp(key, m_keys[i]) ? i : size();
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    index_of_existing(const key_type& key) const
+  {
+    auto i = find_index(key);
+    if (i == size()) {
+      throw std::out_of_range("flat_map::at: no such key");
+    }
+    return i;
+  }
+
+  template<typename K, typename... Args>
+  constexpr //
+    std::pair<iterator, bool>
+    try_emplace_unique(K&& key, Args&&... args)
+  {
+    auto i = lower_bound_index(key);
+    if (i != size() and not m_comp(key, m_keys[i])) {
+      return { at_index(i), false };
+    }
+    auto pos = difference_type(i);
+    m_keys.insert(m_keys.begin() + pos, std::forward<K>(key));
+    try {
+      m_values.emplace(m_values.begin() + pos, std::forward<Args>(args)...);
+    } catch (...) {
+      m_keys.erase(m_keys.begin() + pos);
+      throw;
+    }
+    return { at_index(i), true };
+  }
+
+  template<typename K>
+  constexpr //
+    size_type
+    erase_equal(const K& key)
+  {
+    auto first = lower_bound(key);
+    auto last = upper_bound(key);
+    auto erased = size_type(last - first);
+    erase(first, last);
+    return erased;
+  }
+
+  template<typename InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    if constexpr (std::forward_iterator<InputIt>) {
+      auto count = size() + size_type(std::distance(first, last));
+      m_keys.reserve(count);
+      m_values.reserve(count);
+    }
+    for (; first != last; ++first) {
+      auto value = value_type(*first);
+      m_keys.push_back(std::move(value.first));
+      m_values.push_back(std::move(value.second));
+    }
+  }
+
+  // Sorts the elements from sorted onwards, then merges them into the ones before it.
+  // The keys and values are in different containers, so this sorts their indices instead.
+  constexpr //
+    void
+    sort_unique(size_type sorted)
+  {
+    auto order = vector<size_type>(size() - sorted);
+    std::iota(order.begin(), order.end(), size_type(0));
+    std::sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+      const auto& key_a = m_keys[sorted + a];
+      const auto& key_b = m_keys[sorted + b];
+      // Equivalent keys stay in order, so that the first of them wins
+      return m_comp(key_a, key_b) or (not m_comp(key_b, key_a) and a < b);
+    });
+    merge_unique(sorted, order);
+  }
+
+  // Merges the sorted elements before sorted with the ones after it, taken in the given order,
+  // dropping the later of equivalent keys
+  constexpr //
+    void
+    merge_unique(size_type sorted, const vector<size_type>& order)
+  {
+    auto in_order = sorted == 0 or order.empty() or
+                    m_comp(m_keys[sorted - 1], m_keys[sorted + order.front()]);
+    for (size_type i = 0; in_order and i < order.size(); ++i) {
+      in_order = order[i] == i and (i == 0 or m_comp(m_keys[sorted + i - 1], m_keys[sorted + i]));
+    }
+    if (in_order) {
+      return;
+    }
+
+    auto merged = containers{ detail::empty_like(m_keys), detail::empty_like(m_values) };
+    merged.keys.reserve(size());
+    merged.values.reserve(size());
+    auto take = [&](size_type i) {
+      if (merged.keys.empty() or m_comp(merged.keys.back(), m_keys[i])) {
+        merged.keys.push_back(std::move(m_keys[i]));
+        merged.values.push_back(std::move(m_values[i]));
+      }
+    };
+    auto old = size_type(0);
+    auto added = order.begin();
+    while (old != sorted or added != order.end()) {
+      if (added == order.end() or
+          (old != sorted and not m_comp(m_keys[sorted + *added], m_keys[old]))) {
+        take(old++);
+      } else {
+        take(sorted + *added++);
+      }
+    }
+    m_keys = std::move(merged.keys);
+    m_values = std::move(merged.values);
+  }
+
+  key_container_type m_keys;
+  mapped_container_type m_values;
+  [[no_unique_address]] key_compare m_comp;
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,475 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/vector.h"
+
+namespace constexpr_containers {
+
+// A sorted set kept in a single vector, like C++23's std::flat_set.
+// Lookups are binary searches over contiguous keys, which miss the cache far less than hopping
+// between the nodes of a std::set, but inserting and erasing shifts everything after the element.
+// Everything is constexpr, as long as KeyContainer is.
+//
+// Synopsis:
+//
+// sorted_unique
+//   Tag promising that a range or container is already sorted and free of duplicates,
+//   so that constructors and insert skip sorting it
+// flat_set<Key, Compare = std::less<Key>, KeyContainer = vector<Key>>
+//   The interface of std::flat_set: insert, emplace, erase, find, contains, count, lower_bound,
+//   upper_bound, equal_range (and the heterogeneous versions when Compare::is_transparent),
+//   extract() and replace(keys) to take the container out or put one in, == and <=>.
+//   Lookups use branchless_lower_bound/branchless_upper_bound.
+//   Inserting a range appends it, sorts just the new elements, then merges them in, so building
+//   a set from n keys is O(n log n) rather than the O(n^2) of inserting them one at a time.
+//   Of equivalent keys, the one already in the set is kept (it's unspecified which one, for
+//   equivalent keys within the inserted range).
+
+struct sorted_unique_t
+{
+  explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace detail {
+
+template<typename Compare>
+concept transparent_compare = requires { typename Compare::is_transparent; };
+
+// An empty container using the same allocator as c, if it has one
+template<typename Container>
+[[nodiscard]] constexpr //
+  Container
+  empty_like(const Container& c)
+{
+  if constexpr (requires { c.get_allocator(); }) {
+    return Container(c.get_allocator());
+  } else {
+    return Container();
+  }
+}
+
+} // namespace detail
+
+template<typename Key, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>>
+class flat_set
+{
+public:
+  //////////////////
+  // Member types //
+  //////////////////
+
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = typename KeyContainer::size_type;
+  using difference_type = typename KeyContainer::difference_type;
+  // Elements can't be modified in place, that could break the ordering
+  using iterator = typename KeyContainer::const_iterator;
+  using const_iterator = typename KeyContainer::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using container_type = KeyContainer;
+
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr flat_set() = default;
+  constexpr explicit flat_set(const key_compare& comp)
+    : m_keys()
+    , m_comp(comp)
+  {}
+  constexpr explicit flat_set(container_type keys, const key_compare& comp = key_compare())
+    : m_keys(std::move(keys))
+    , m_comp(comp)
+  {
+    sort_unique(0);
+  }
+  constexpr flat_set(sorted_unique_t, container_type keys, const key_compare& comp = key_compare())
+    : m_keys(std::move(keys))
+    , m_comp(comp)
+  {}
+  template<std::input_iterator InputIt>
+  constexpr flat_set(InputIt first, InputIt last, const key_compare& comp = key_compare())
+    : m_keys()
+    , m_comp(comp)
+  {
+    insert(first, last);
+  }
+  template<std::input_iterator InputIt>
+  constexpr flat_set(sorted_unique_t,
+                     InputIt first,
+                     InputIt last,
+                     const key_compare& comp = key_compare())
+    : m_keys(first, last)
+    , m_comp(comp)
+  {}
+  constexpr flat_set(std::initializer_list<value_type> il, const key_compare& comp = key_compare())
+    : flat_set(il.begin(), il.end(), comp)
+  {}
+  constexpr flat_set(sorted_unique_t,
+                     std::initializer_list<value_type> il,
+                     const key_compare& comp = key_compare())
+    : flat_set(sorted_unique, il.begin(), il.end(), comp)
+  {}
+
+  constexpr flat_set& operator=(std::initializer_list<value_type> il)
+  {
+    clear();
+    insert(il);
+    return *this;
+  }
+
+  ///////////////
+  // Iterators //
+  ///////////////
+
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return m_keys.begin(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return m_keys.end(); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+  [[nodiscard]] constexpr //
+    const_reverse_iterator
+    rbegin() //
+    const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+  [[nodiscard]] constexpr //
+    const_reverse_iterator
+    rend() //
+    const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+  [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+  //////////////
+  // Capacity //
+  //////////////
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return m_keys.empty(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return m_keys.size(); }
+  [[nodiscard]] constexpr size_type max_size() const noexcept { return m_keys.max_size(); }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename... Args>
+  constexpr //
+    std::pair<iterator, bool>
+    emplace(Args&&... args)
+  {
+    return insert_unique(value_type(std::forward<Args>(args)...));
+  }
+  template<typename... Args>
+  constexpr //
+    iterator
+    emplace_hint(const_iterator, Args&&... args)
+  {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  constexpr //
+    std::pair<iterator, bool>
+    insert(const value_type& value)
+  {
+    return insert_unique(value);
+  }
+  constexpr //
+    std::pair<iterator, bool>
+    insert(value_type&& value)
+  {
+    return insert_unique(std::move(value));
+  }
+  constexpr //
+    iterator
+    insert(const_iterator, const value_type& value)
+  {
+    return insert_unique(value).first;
+  }
+  constexpr //
+    iterator
+    insert(const_iterator, value_type&& value)
+  {
+    return insert_unique(std::move(value)).first;
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    insert(InputIt first, InputIt last)
+  {
+    auto sorted = size();
+    append(first, last);
+    sort_unique(sorted);
+  }
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    insert(sorted_unique_t, InputIt first, InputIt last)
+  {
+    auto sorted = size();
+    append(first, last);
+    merge_unique(sorted);
+  }
+  constexpr void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+  constexpr //
+    void
+    insert(sorted_unique_t, std::initializer_list<value_type> il)
+  {
+    insert(sorted_unique, il.begin(), il.end());
+  }
+
+  [[nodiscard]] constexpr container_type extract() && { return std::move(m_keys); }
+  // keys has to be sorted and free of duplicates
+  constexpr void replace(container_type&& keys) { m_keys = std::move(keys); }
+
+  constexpr iterator erase(const_iterator pos) { return m_keys.erase(pos); }
+  constexpr //
+    iterator
+    erase(const_iterator first, const_iterator last)
+  {
+    return m_keys.erase(first, last);
+  }
+  constexpr //
+    size_type
+    erase(const key_type& key)
+  {
+    return erase_equal(key);
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  constexpr //
+    size_type
+    erase(const K& key)
+  {
+    return erase_equal(key);
+  }
+
+  constexpr void clear() noexcept { m_keys.clear(); }
+
+  constexpr //
+    void
+    swap(flat_set& other) //
+    noexcept(std::is_nothrow_swappable_v<container_type> and
+             std::is_nothrow_swappable_v<key_compare>)
+  {
+    using std::swap;
+    swap(m_keys, other.m_keys);
+    swap(m_comp, other.m_comp);
+  }
+
+  friend constexpr //
+    void
+    swap(flat_set& a, flat_set& b) //
+    noexcept(noexcept(a.swap(b)))
+  {
+    a.swap(b);
+  }
+
+  ///////////////
+  // Observers //
+  ///////////////
+
+  [[nodiscard]] constexpr key_compare key_comp() const { return m_comp; }
+  [[nodiscard]] constexpr value_compare value_comp() const { return m_comp; }
+
+  ////////////
+  // Lookup //
+  ////////////
+
+  [[nodiscard]] constexpr const_iterator find(const key_type& key) const { return find_equal(key); }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    const_iterator
+    find(const K& key) const
+  {
+    return find_equal(key);
+  }
+
+  [[nodiscard]] constexpr bool contains(const key_type& key) const { return find(key) != end(); }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    bool
+    contains(const K& key) const
+  {
+    return find(key) != end();
+  }
+
+  [[nodiscard]] constexpr size_type count(const key_type& key) const { return contains(key); }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    size_type
+    count(const K& key) const
+  {
+    return contains(key);
+  }
+
+  [[nodiscard]] constexpr //
+    const_iterator
+    lower_bound(const key_type& key) const
+  {
+    return branchless_lower_bound(begin(), end(), key, m_comp);
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    const_iterator
+    lower_bound(const K& key) const
+  {
+    return branchless_lower_bound(begin(), end(), key, m_comp);
+  }
+
+  [[nodiscard]] constexpr //
+    const_iterator
+    upper_bound(const key_type& key) const
+  {
+    return branchless_upper_bound(begin(), end(), key, m_comp);
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    const_iterator
+    upper_bound(const K& key) const
+  {
+    return branchless_upper_bound(begin(), end(), key, m_comp);
+  }
+
+  [[nodiscard]] constexpr //
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const
+  {
+    auto it = find(key);
+    return { it, it == end() ? it : std::next(it) };
+  }
+  template<typename K>
+    requires detail::transparent_compare<Compare>
+  [[nodiscard]] constexpr //
+    std::pair<const_iterator, const_iterator>
+    equal_range(const K& key) const
+  {
+    // Several keys may be equivalent to a K
+    return { lower_bound(key), upper_bound(key) };
+  }
+
+  //////////////////////////
+  // Comparison operators //
+  //////////////////////////
+
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const flat_set& a, const flat_set& b)
+  {
+    return a.m_keys == b.m_keys;
+  }
+
+  [[nodiscard]] friend constexpr //
+    auto
+    operator<=>(const flat_set& a, const flat_set& b)
+  {
+    return a.m_keys <=> b.m_keys;
+  }
+
+private:
+  template<typename K>
+  constexpr //
+    std::pair<iterator, bool>
+    insert_unique(K&& key)
+  {
+    auto it = lower_bound(key);
+    if (it != end() and not m_comp(key, *it)) {
+      return { it, false };
+    }
+    return { m_keys.insert(it, std::forward<K>(key)), true };
+  }
+
+  template<typename K>
+  [[nodiscard]] constexpr //
+    const_iterator
+    find_equal(const K& key) const
+  {
+    auto it = lower_bound(key);
+    return it != end() and not m_comp(key, *it) ? it : end();
+  }
+
+  template<typename K>
+  constexpr //
+    size_type
+    erase_equal(const K& key)
+  {
+    auto first = lower_bound(key);
+    auto last = upper_bound(key);
+    auto erased = size_type(last - first);
+    m_keys.erase(first, last);
+    return erased;
+  }
+
+  template<typename InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    if constexpr (std::forward_iterator<InputIt>) {
+      m_keys.reserve(size() + size_type(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      m_keys.emplace_back(*first);
+    }
+  }
+
+  // Sorts the elements from sorted onwards, then merges them into the ones before it
+  constexpr //
+    void
+    sort_unique(size_type sorted)
+  {
+    std::sort(m_keys.begin() + difference_type(sorted), m_keys.end(), m_comp);
+    merge_unique(sorted);
+  }
+
+  // Merges the sorted ranges before and after sorted, dropping the later of equivalent keys
+  constexpr //
+    void
+    merge_unique(size_type sorted)
+  {
+    auto middle = m_keys.begin() + difference_type(sorted);
+    if (middle != m_keys.begin() and middle != m_keys.end() and
+        m_comp(*middle, *std::prev(middle))) {
+      auto merged = detail::empty_like(m_keys);
+      merged.reserve(size());
+      std::merge(std::make_move_iterator(m_keys.begin()),
+                 std::make_move_iterator(middle),
+                 std::make_move_iterator(middle),
+                 std::make_move_iterator(m_keys.end()),
+                 std::back_inserter(merged),
+                 m_comp);
+      m_keys = std::move(merged);
+    }
+    auto equivalent = [&](const key_type& a, const key_type& b) { return not m_comp(a, b); };
+    m_keys.erase(std::unique(m_keys.begin(), m_keys.end(), equivalent), m_keys.end());
+  }
+
+  container_type m_keys;
+  [[no_unique_address]] key_compare m_comp;
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace constexpr_containers {
+
+// Gets the elements of a vector built during constant evaluation into runtime code.
+// A vector's allocation has to be freed before constant evaluation ends, so it can't be a
+// constexpr variable itself, but a std::array of the right size can.
+//
+// Synopsis:
+//
+// frozen<builder>
+//   A constexpr std::array holding the elements of the vector (or any other sized range)
+//   returned by builder(). Being a constant, it lives in read-only data, and costs nothing at
+//   startup. builder is called twice during constant evaluation, once for the size and once for
+//   the elements, so it has to return the same elements both times. The elements have to be
+//   default constructible and copyable.
+// freeze<builder>()
+//   A std::span<const T, N> over frozen<builder>
+//
+// e.g.
+//   constexpr auto squares = freeze<[] {
+//     vector<int> v;
+//     for (int i = 0; i < 10; ++i) {
+//       v.push_back(i * i);
+//     }
+//     return v;
+//   }>();
+
+namespace detail {
+
+template<auto Builder>
+using built_range_t = std::remove_cvref_t<decltype(Builder())>;
+
+template<auto Builder>
+inline constexpr std::size_t frozen_size = std::ranges::size(Builder());
+
+} // namespace detail
+
+template<auto Builder>
+  requires std::ranges::sized_range<detail::built_range_t<Builder>>
+inline constexpr auto frozen = [] {
+  using T = std::ranges::range_value_t<detail::built_range_t<Builder>>;
+  static_assert(std::default_initializable<T>, "frozen elements have to be default constructible");
+  auto elements = std::array<T, detail::frozen_size<Builder>>{};
+  auto range = Builder();
+  std::ranges::copy(range, elements.begin());
+  return elements;
+}();
+
+template<auto Builder>
+[[nodiscard]] constexpr //
+  auto
+  freeze() //
+  noexcept
+{
+  using T = typename decltype(frozen<Builder>)::value_type;
+  return std::span<const T, detail::frozen_size<Builder>>(frozen<Builder>);
+}
+
+} // namespace constexpr_containers
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "constexpr_containers/allocator.h"
+
+namespace constexpr_containers {
+
+// Growth policies decide how much capacity vector_base asks for when it runs out of room.
+//
+// A growth policy is any type with a static member function
+//
+//   static constexpr std::size_t
+//     next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size);
+//
+// which is given the current capacity, the minimum capacity needed, and sizeof(value_type).
+// Returning less than required is allowed (vector_base will just allocate required elements),
+// so policies don't have to care about overflow or max_size.
+//
+// Synopsis:
+//
+// growth::doubling
+//   2x growth, the default. Fewest reallocations, but wastes up to half the memory.
+// growth::one_and_a_half
+//   1.5x growth. Wastes up to a third of the memory, and lets the allocator reuse
+//   previously freed blocks for later growth, since 1 + 1.5 + ... eventually exceeds the next size.
+// growth::size_class<Policy, PageSize>
+//   Grows according to Policy, then rounds the allocation up to what a typical malloc would hand
+//   back anyway (see size_class_bytes): powers of two for small blocks, whole pages for large ones.
+// growth::fixed_increment<N>
+//   Grows by N elements at a time. Minimal waste, but quadratic total copying if used carelessly.
+
+namespace growth {
+
+struct doubling
+{
+  [[nodiscard]] static constexpr //
+    std::size_t
+    next_capacity(std::size_t capacity, std::size_t required, std::size_t /*element_size*/) //
+    noexcept
+  {
+    return std::max(required, capacity * 2);
+  }
+};
+
+struct one_and_a_half
+{
+  [[nodiscard]] static constexpr //
+    std::size_t
+    next_capacity(std::size_t capacity, std::size_t required, std::size_t /*element_size*/) //
+    noexcept
+  {
+    return std::max(required, capacity + capacity / 2);
+  }
+};
+
+template<typename Policy = doubling, std::size_t PageSize = 4096>
+struct size_class
+{
+  [[nodiscard]] static constexpr //
+    std::size_t
+    next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size) //
+    noexcept
+  {
+    auto bytes = Policy::next_capacity(capacity, required, element_size) * element_size;
+    return size_class_bytes(bytes, PageSize) / element_size;
+  }
+};
+
+template<std::size_t N>
+struct fixed_increment
+{
+  static_assert(N > 0, "fixed_increment must grow by at least one element");
+
+  [[nodiscard]] static constexpr //
+    std::size_t
+    next_capacity(std::size_t capacity, std::size_t required, std::size_t /*element_size*/) //
+    noexcept
+  {
+    return std::max(required, capacity + N);
+  }
+};
+
+} // namespace growth
+
+} // namespace constexpr_containers
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "constexpr_containers/type_traits.h"
+
+namespace constexpr_containers {
+
+// The deferred launder smart iterator promised in the README.
+//
+// Synopsis:
+//
+// maybe_launder(p)
+//   std::launder(p) if needs_launder_v<T>, p otherwise
+// launder_iterator<T>
+//   A contiguous iterator over T (or const T) which launders only when it is dereferenced,
+//   so that iterating, comparing and doing arithmetic is exactly like using a plain pointer.
+//   It converts implicitly from T* and from launder_iterator<U> when U* converts to T*.
+//   std::to_address never launders, so it's fine to call it on past-the-end iterators.
+
+template<typename T>
+[[nodiscard]] constexpr //
+  T*
+  maybe_launder(T* p) //
+  noexcept
+{
+  if constexpr (needs_launder_v<std::remove_cv_t<T>>) {
+    return std::launder(p);
+  } else {
+    return p;
+  }
+}
+
+template<typename T>
+class launder_iterator
+{
+public:
+  using iterator_concept = std::contiguous_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using element_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  constexpr launder_iterator() noexcept = default;
+  constexpr launder_iterator(T* p) noexcept
+    : m_ptr(p)
+  {}
+  template<typename U>
+  constexpr launder_iterator(const launder_iterator<U>& other) noexcept
+    requires std::is_convertible_v<U*, T*>
+    : m_ptr(other.base())
+  {}
+
+  [[nodiscard]] constexpr T* base() const noexcept { return m_ptr; }
+
+  [[nodiscard]] constexpr /**/ reference operator*() /***/ const noexcept { return *launder(); }
+  [[nodiscard]] constexpr /****/ pointer operator->() /**/ const noexcept { return launder(); }
+  [[nodiscard]] constexpr //
+    reference
+    operator[](difference_type n) //
+    const noexcept
+  {
+    return *maybe_launder(m_ptr + n);
+  }
+
+  constexpr launder_iterator& operator++() noexcept
+  {
+    ++m_ptr;
+    return *this;
+  }
+  constexpr launder_iterator& operator--() noexcept
+  {
+    --m_ptr;
+    return *this;
+  }
+  constexpr launder_iterator operator++(int) noexcept { return launder_iterator(m_ptr++); }
+  constexpr launder_iterator operator--(int) noexcept { return launder_iterator(m_ptr--); }
+
+  constexpr launder_iterator& operator+=(difference_type n) noexcept
+  {
+    m_ptr += n;
+    return *this;
+  }
+  constexpr launder_iterator& operator-=(difference_type n) noexcept
+  {
+    m_ptr -= n;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr //
+    launder_iterator
+    operator+(launder_iterator it, difference_type n) //
+    noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr //
+    launder_iterator
+    operator+(difference_type n, launder_iterator it) //
+    noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr //
+    launder_iterator
+    operator-(launder_iterator it, difference_type n) //
+    noexcept
+  {
+    return it -= n;
+  }
+  [[nodiscard]] friend constexpr //
+    difference_type
+    operator-(const launder_iterator& a, const launder_iterator& b) //
+    noexcept
+  {
+    return a.m_ptr - b.m_ptr;
+  }
+
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const launder_iterator& a, const launder_iterator& b) //
+    noexcept
+  {
+    return a.m_ptr == b.m_ptr;
+  }
+  [[nodiscard]] friend constexpr //
+    std::strong_ordering
+    operator<=>(const launder_iterator& a, const launder_iterator& b) //
+    noexcept
+  {
+    return a.m_ptr <=> b.m_ptr;
+  }
+
+private:
+  [[nodiscard]] constexpr T* launder() const noexcept { return maybe_launder(m_ptr); }
+
+  T* m_ptr = nullptr;
+};
+
+} // namespace constexpr_containers
+
+// Lets std::to_address skip operator->, which would launder
+template<typename T>
+struct std::pointer_traits<constexpr_containers::launder_iterator<T>>
+{
+  using pointer = constexpr_containers::launder_iterator<T>;
+  using element_type = T;
+  using difference_type = std::ptrdiff_t;
+
+  [[nodiscard]] static constexpr T* to_address(const pointer& p) noexcept { return p.base(); }
+};
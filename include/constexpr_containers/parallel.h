@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "constexpr_containers/algorithm.h"
+
+namespace constexpr_containers {
+
+// Parallel versions of the zip algorithms in algorithm.h. These are runtime only.
+//
+// Synopsis:
+//
+// thread_pool(workers)
+//   A fixed set of worker threads. run(count, max_threads, fn) calls fn(i) for every i in
+//   0..count, spread over the workers and the calling thread, and returns once they're all done.
+//   If any call throws, the remaining ones are skipped and the first exception is rethrown.
+//   Calls to run made from inside fn run sequentially instead of deadlocking.
+// default_thread_pool()
+//   A thread_pool shared by everything, with one worker less than the hardware has threads
+//   (the calling thread makes up for it)
+// parallel{ threads, chunk_size, pool }
+//   How to split up an algorithm: into tasks of chunk_size elements, run on at most threads
+//   threads of pool. Zeros (and nullptr) pick defaults, see below.
+// zip_transform(parallel, fst, fst_end, dst, n-ary op, [snd, third, rest...])
+// zip_foreach(parallel, fst, fst_end, n-ary op, [snd, third, rest...])
+//   Like the sequential versions, splitting the index space into chunks when every iterator
+//   (including dst) is random access, and running sequentially otherwise. op is copied, and
+//   must be safe to call concurrently on different elements. Elements are written in the
+//   same places as the sequential versions would, so the results are the same.
+// zip_transform(policy, ...)
+// zip_foreach(policy, ...)
+//   Take a standard execution policy instead: seq and unseq run sequentially, par and par_unseq
+//   use default_thread_pool(). Only declared if <execution> was included before this header,
+//   so that the thread pool doesn't drag in <execution> (and, with libstdc++, TBB).
+
+namespace detail {
+
+// Set on the pool's workers, and on threads while they're helping with a run
+inline thread_local bool inside_thread_pool = false;
+
+} // namespace detail
+
+class thread_pool
+{
+public:
+  explicit thread_pool(std::size_t workers)
+  {
+    m_workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      m_workers.emplace_back([this, i] { work_loop(i); });
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool()
+  {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  [[nodiscard]] std::size_t workers() const noexcept { return m_workers.size(); }
+
+  // max_threads counts the calling thread, 0 means no limit
+  template<typename Fn>
+  void run(std::size_t count, std::size_t max_threads, Fn&& fn)
+  {
+    auto helpers = std::min(max_threads == 0 ? m_workers.size() : max_threads - 1,
+                            std::min(m_workers.size(), count == 0 ? 0 : count - 1));
+    if (helpers == 0 or detail::inside_thread_pool) {
+      for (std::size_t i = 0; i < count; ++i) {
+        fn(i);
+      }
+      return;
+    }
+
+    // One run at a time, the workers only know about a single job
+    auto run_lock = std::lock_guard(m_run_mutex);
+    {
+      auto lock = std::lock_guard(m_mutex);
+      auto ctx = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+      m_job = job{ call<std::remove_reference_t<Fn>>, ctx, count, helpers };
+      m_next.store(0, std::memory_order_relaxed);
+      m_busy = helpers;
+      ++m_generation;
+    }
+    m_wake.notify_all();
+
+    detail::inside_thread_pool = true;
+    work();
+    detail::inside_thread_pool = false;
+
+    auto error = std::exception_ptr();
+    {
+      auto lock = std::unique_lock(m_mutex);
+      m_done.wait(lock, [&] { return m_busy == 0; });
+      error = std::exchange(m_error, nullptr);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  struct job
+  {
+    void (*fn)(void*, std::size_t);
+    void* ctx;
+    std::size_t count;
+    std::size_t helpers;
+  };
+
+  template<typename Fn>
+  static void call(void* ctx, std::size_t i)
+  {
+    (*static_cast<Fn*>(ctx))(i);
+  }
+
+  void work_loop(std::size_t index)
+  {
+    detail::inside_thread_pool = true;
+    auto seen = std::uint64_t(0);
+    while (true) {
+      {
+        auto lock = std::unique_lock(m_mutex);
+        m_wake.wait(lock, [&] { return m_stop or m_generation != seen; });
+        if (m_stop) {
+          return;
+        }
+        seen = m_generation;
+        if (index >= m_job.helpers) {
+          continue;
+        }
+      }
+      work();
+      {
+        auto lock = std::lock_guard(m_mutex);
+        if (--m_busy == 0) {
+          m_done.notify_one();
+        }
+      }
+    }
+  }
+
+  // Grabs indices until there are none left
+  void work() noexcept
+  {
+    for (auto i = m_next.fetch_add(1); i < m_job.count; i = m_next.fetch_add(1)) {
+      try {
+        m_job.fn(m_job.ctx, i);
+      } catch (...) {
+        auto lock = std::lock_guard(m_mutex);
+        if (not m_error) {
+          m_error = std::current_exception();
+        }
+        m_next.store(m_job.count);
+      }
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_run_mutex;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  bool m_stop = false;
+  std::uint64_t m_generation = 0;
+  job m_job{};
+  std::atomic<std::size_t> m_next{ 0 };
+  std::size_t m_busy = 0;
+  std::exception_ptr m_error;
+};
+
+inline thread_pool&
+default_thread_pool()
+{
+  static auto pool = thread_pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+  return pool;
+}
+
+struct parallel
+{
+  // At most this many threads, counting the calling one. 0 uses every thread of the pool.
+  std::size_t threads = 0;
+  // Elements per task. 0 gives every thread about 4 tasks, but no less than min_chunk_size
+  // elements each, so that small ranges aren't split up for nothing.
+  std::size_t chunk_size = 0;
+  // nullptr means default_thread_pool()
+  thread_pool* pool = nullptr;
+
+  static constexpr std::size_t min_chunk_size = 4096;
+};
+
+namespace detail {
+
+// Calls fn(begin, end) on chunks of 0..count
+template<typename Fn>
+void
+parallel_chunks(const parallel& params, std::size_t count, Fn fn)
+{
+  auto& pool = params.pool ? *params.pool : default_thread_pool();
+  auto threads = params.threads == 0 ? pool.workers() + 1 : params.threads;
+  auto chunk = params.chunk_size;
+  if (chunk == 0) {
+    chunk = std::max(count / (threads * 4), parallel::min_chunk_size);
+  }
+  auto chunks = (count + chunk - 1) / chunk;
+  pool.run(chunks, threads, [&](std::size_t i) {
+    auto begin = i * chunk;
+    fn(begin, std::min(begin + chunk, count));
+  });
+}
+
+} // namespace detail
+
+template<std::input_or_output_iterator OutputIt,
+         std::input_iterator FstIt,
+         typename Op,
+         std::input_iterator... RestIt>
+OutputIt
+zip_transform(const parallel& params,
+              FstIt fst,
+              FstIt fst_end,
+              OutputIt dst,
+              Op op,
+              RestIt... rest)
+{
+  if constexpr (std::random_access_iterator<FstIt> and std::random_access_iterator<OutputIt> and
+                (std::random_access_iterator<RestIt> and ...)) {
+    auto count = static_cast<std::size_t>(fst_end - fst);
+    detail::parallel_chunks(params, count, [&](std::size_t begin, std::size_t end) {
+      using diff = std::iter_difference_t<FstIt>;
+      zip_transform(
+        fst + diff(begin), fst + diff(end), dst + diff(begin), op, (rest + diff(begin))...);
+    });
+    return dst + std::iter_difference_t<OutputIt>(count);
+  } else {
+    return zip_transform(fst, fst_end, dst, std::move(op), rest...);
+  }
+}
+
+template<std::input_iterator FstIt, typename Op, std::input_iterator... RestIt>
+void
+zip_foreach(const parallel& params, FstIt fst, FstIt fst_end, Op op, RestIt... rest)
+{
+  if constexpr (std::random_access_iterator<FstIt> and
+                (std::random_access_iterator<RestIt> and ...)) {
+    auto count = static_cast<std::size_t>(fst_end - fst);
+    detail::parallel_chunks(params, count, [&](std::size_t begin, std::size_t end) {
+      using diff = std::iter_difference_t<FstIt>;
+      zip_foreach(fst + diff(begin), fst + diff(end), op, (rest + diff(begin))...);
+    });
+  } else {
+    zip_foreach(fst, fst_end, std::move(op), rest...);
+  }
+}
+
+// libstdc++ and libc++ guard <execution> with these
+#if defined(_GLIBCXX_EXECUTION) or defined(_LIBCPP_EXECUTION)
+
+namespace detail {
+
+template<typename ExecutionPolicy>
+inline constexpr bool is_parallel_policy_v =
+  std::is_same_v<ExecutionPolicy, std::execution::parallel_policy> or
+  std::is_same_v<ExecutionPolicy, std::execution::parallel_unsequenced_policy>;
+
+} // namespace detail
+
+template<typename ExecutionPolicy,
+         std::input_or_output_iterator OutputIt,
+         std::input_iterator FstIt,
+         typename Op,
+         std::input_iterator... RestIt>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+OutputIt
+zip_transform(ExecutionPolicy&&, FstIt fst, FstIt fst_end, OutputIt dst, Op op, RestIt... rest)
+{
+  if constexpr (detail::is_parallel_policy_v<std::remove_cvref_t<ExecutionPolicy>>) {
+    return zip_transform(parallel{}, fst, fst_end, dst, std::move(op), rest...);
+  } else {
+    return zip_transform(fst, fst_end, dst, std::move(op), rest...);
+  }
+}
+
+template<typename ExecutionPolicy,
+         std::input_iterator FstIt,
+         typename Op,
+         std::input_iterator... RestIt>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+void
+zip_foreach(ExecutionPolicy&&, FstIt fst, FstIt fst_end, Op op, RestIt... rest)
+{
+  if constexpr (detail::is_parallel_policy_v<std::remove_cvref_t<ExecutionPolicy>>) {
+    zip_foreach(parallel{}, fst, fst_end, std::move(op), rest...);
+  } else {
+    zip_foreach(fst, fst_end, std::move(op), rest...);
+  }
+}
+
+#endif
+
+} // namespace constexpr_containers
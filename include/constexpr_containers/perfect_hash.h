@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/freeze.h"
+#include "constexpr_containers/vector.h"
+
+namespace constexpr_containers {
+
+// A fixed map from keys known at compile time, with a perfect hash function found by a
+// constexpr search, for keyword, opcode and config key tables.
+//
+// It works like PTHash: keys are split into buckets by their hash, and each bucket gets a small
+// number, its pilot, which is mixed into the hashes of its keys to place them. Starting from the
+// biggest bucket, the search tries pilots until every key of the bucket lands on a free slot.
+// A lookup then hashes the key once, reads the pilot of its bucket, and compares against the
+// single slot the key can be in. About 5 keys share a bucket, and the table is at most 80% full.
+//
+// Synopsis:
+//
+// seeded_hash
+//   The default hash function, hash(key, seed), for integers, enums and anything that converts
+//   to std::string_view. Custom ones have to be constexpr and return a std::uint64_t.
+// perfect_hash_map<Key, T, N, Hash = seeded_hash>
+//   A map of exactly N keys, built by its constexpr constructor from any sized range of pairs
+//   (e.g. a vector<std::pair<Key, T>>). It's a literal type, so it can be a constexpr variable.
+//   Key and T have to be default constructible, and a Key has to be usable in constant
+//   expressions for the map to be one (std::string_view rather than std::string).
+//   The constructor throws if the keys aren't unique, which fails compilation when constant
+//   evaluated.
+//   find(key) returns a pointer to the value or nullptr, and contains, at (which throws
+//   std::out_of_range) and operator[] (which doesn't check) work as usual.
+//   slots() is the whole table, to iterate over.
+// make_perfect_hash_map<builder, Hash = seeded_hash>()
+//   The perfect_hash_map of the pairs builder() returns, sized like freeze<builder>() is.
+//   builder runs twice.
+
+namespace detail {
+
+// The finalizer of MurmurHash3, which spreads every input bit over the whole output
+[[nodiscard]] constexpr //
+  std::uint64_t
+  mix64(std::uint64_t x) //
+  noexcept
+{
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return x;
+}
+
+// At most 80% full, and a power of two so that positions are a multiply and a shift
+[[nodiscard]] constexpr //
+  std::size_t
+  perfect_hash_slots(std::size_t keys) //
+  noexcept
+{
+  return std::bit_ceil(std::max(keys + keys / 4, std::size_t(2)));
+}
+
+[[nodiscard]] constexpr //
+  std::size_t
+  perfect_hash_buckets(std::size_t keys) //
+  noexcept
+{
+  return std::max(keys / 5, std::size_t(1));
+}
+
+} // namespace detail
+
+struct seeded_hash
+{
+  template<typename Key>
+    requires std::is_integral_v<Key> or std::is_enum_v<Key>
+  [[nodiscard]] constexpr //
+    std::uint64_t
+    operator()(Key key, std::uint64_t seed) //
+    const noexcept
+  {
+    return detail::mix64(std::uint64_t(key) ^ (seed * 0x9e3779b97f4a7c15ull));
+  }
+
+  // Reads 8 bytes at a time, assembled by hand so that compile time and runtime agree
+  [[nodiscard]] constexpr //
+    std::uint64_t
+    operator()(std::string_view key, std::uint64_t seed) //
+    const noexcept
+  {
+    auto h = detail::mix64(seed ^ key.size());
+    auto i = std::size_t(0);
+    auto word = [&](std::size_t count) {
+      auto w = std::uint64_t(0);
+      for (std::size_t j = 0; j < count; ++j) {
+        w |= std::uint64_t(static_cast<unsigned char>(key[i + j])) << (8 * j);
+      }
+      return w;
+    };
+    for (; i + 8 <= key.size(); i += 8) {
+      h = (h ^ word(8)) * 0xbf58476d1ce4e5b9ull;
+      h ^= h >> 31;
+    }
+    h ^= word(key.size() - i);
+    return detail::mix64(h);
+  }
+};
+
+template<typename Key, typename T, std::size_t N, typename Hash = seeded_hash>
+class perfect_hash_map
+{
+public:
+  //////////////////
+  // Member types //
+  //////////////////
+
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = std::size_t;
+  using hasher = Hash;
+
+  static constexpr size_type slot_count = detail::perfect_hash_slots(N);
+  static constexpr size_type bucket_count = detail::perfect_hash_buckets(N);
+
+  struct slot
+  {
+    Key key{};
+    T value{};
+    bool used = false;
+  };
+
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  template<std::ranges::sized_range Range>
+  constexpr explicit perfect_hash_map(const Range& pairs, const Hash& hash = Hash())
+    : m_hash(hash)
+  {
+    if (std::ranges::size(pairs) != N) {
+      throw std::length_error("perfect_hash_map: wrong number of keys");
+    }
+    auto keys = vector<Key>();
+    auto values = vector<T>();
+    keys.reserve(N);
+    values.reserve(N);
+    for (const auto& pair : pairs) {
+      keys.push_back(std::get<0>(pair));
+      values.push_back(std::get<1>(pair));
+    }
+    for (std::uint64_t seed = 0; seed < max_seeds; ++seed) {
+      if (try_build(keys, values, seed)) {
+        return;
+      }
+    }
+    throw std::logic_error("perfect_hash_map: no perfect hash found");
+  }
+
+  //////////////
+  // Capacity //
+  //////////////
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return N == 0; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return N; }
+
+  ////////////
+  // Lookup //
+  ////////////
+
+  [[nodiscard]] constexpr //
+    const T*
+    find(const Key& key) const
+  {
+    const auto& s = m_slots[position(key)];
+    return s.used and s.key == key ? &s.value : nullptr;
+  }
+
+  [[nodiscard]] constexpr bool contains(const Key& key) const { return find(key) != nullptr; }
+
+  [[nodiscard]] constexpr //
+    const T&
+    at(const Key& key) const
+  {
+    auto value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("perfect_hash_map::at: no such key");
+    }
+    return *value;
+  }
+
+  // key has to be in the map
+  [[nodiscard]] constexpr //
+    const T&
+    operator[](const Key& key) const
+  {
+    return m_slots[position(key)].value;
+  }
+
+  // The whole table, where used marks the slots holding a key
+  [[nodiscard]] constexpr //
+    const std::array<slot, slot_count>&
+    slots() //
+    const noexcept
+  {
+    return m_slots;
+  }
+
+private:
+  static constexpr std::uint64_t max_seeds = 64;
+  static constexpr std::uint32_t max_pilot = 0xffff;
+  static constexpr int position_shift = 64 - std::countr_zero(slot_count);
+
+  [[nodiscard]] static constexpr //
+    size_type
+    bucket(std::uint64_t h) //
+    noexcept
+  {
+    return size_type(((h >> 32) * bucket_count) >> 32);
+  }
+
+  [[nodiscard]] static constexpr //
+    size_type
+    position(std::uint64_t h, std::uint32_t pilot) //
+    noexcept
+  {
+    return size_type(((h ^ detail::mix64(pilot)) * 0x9e3779b97f4a7c15ull) >> position_shift);
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    position(const Key& key) const
+  {
+    auto h = m_hash(key, m_seed);
+    return position(h, m_pilots[bucket(h)]);
+  }
+
+  // Whether every bucket found a pilot with this seed
+  constexpr bool try_build(const vector<Key>& keys, const vector<T>& values, std::uint64_t seed)
+  {
+    auto hashes = vector<std::uint64_t>(N);
+    auto sizes = vector<size_type>(bucket_count);
+    for (size_type i = 0; i < N; ++i) {
+      hashes[i] = m_hash(keys[i], seed);
+      ++sizes[bucket(hashes[i])];
+    }
+    // The biggest buckets are the hardest to place, so they go first, while the table is empty
+    auto order = vector<size_type>(N);
+    std::iota(order.begin(), order.end(), size_type(0));
+    std::sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+      auto bucket_a = bucket(hashes[a]);
+      auto bucket_b = bucket(hashes[b]);
+      if (sizes[bucket_a] != sizes[bucket_b]) {
+        return sizes[bucket_a] > sizes[bucket_b];
+      }
+      return bucket_a != bucket_b ? bucket_a < bucket_b : hashes[a] < hashes[b];
+    });
+    // Keys with the same hash collide whatever the pilot
+    for (size_type i = 1; i < N; ++i) {
+      if (hashes[order[i - 1]] == hashes[order[i]]) {
+        if (keys[order[i - 1]] == keys[order[i]]) {
+          throw std::invalid_argument("perfect_hash_map: duplicate key");
+        }
+        return false;
+      }
+    }
+
+    m_slots = {};
+    auto taken = vector<bool>(slot_count);
+    auto positions = vector<size_type>();
+    for (size_type first = 0; first < N;) {
+      auto b = bucket(hashes[order[first]]);
+      auto last = first + sizes[b];
+      auto pilot = std::uint32_t(0);
+      for (;; ++pilot) {
+        if (pilot > max_pilot) {
+          return false;
+        }
+        positions.clear();
+        for (auto i = first; i < last; ++i) {
+          auto p = position(hashes[order[i]], pilot);
+          if (taken[p] or std::find(positions.begin(), positions.end(), p) != positions.end()) {
+            break;
+          }
+          positions.push_back(p);
+        }
+        if (positions.size() == last - first) {
+          break;
+        }
+      }
+      m_pilots[b] = static_cast<std::uint16_t>(pilot);
+      for (auto i = first; i < last; ++i) {
+        auto p = positions[i - first];
+        taken[p] = true;
+        m_slots[p] = slot{ keys[order[i]], values[order[i]], true };
+      }
+      first = last;
+    }
+    m_seed = seed;
+    return true;
+  }
+
+  std::array<slot, slot_count> m_slots{};
+  std::array<std::uint16_t, bucket_count> m_pilots{};
+  std::uint64_t m_seed = 0;
+  [[no_unique_address]] Hash m_hash;
+};
+
+template<auto Builder, typename Hash = seeded_hash>
+[[nodiscard]] constexpr //
+  auto
+  make_perfect_hash_map()
+{
+  using pair_type = std::ranges::range_value_t<detail::built_range_t<Builder>>;
+  using key_type = std::remove_cvref_t<std::tuple_element_t<0, pair_type>>;
+  using mapped_type = std::remove_cvref_t<std::tuple_element_t<1, pair_type>>;
+  return perfect_hash_map<key_type, mapped_type, detail::frozen_size<Builder>, Hash>(Builder());
+}
+
+} // namespace constexpr_containers
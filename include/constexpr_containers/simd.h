@@ -0,0 +1,315 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <immintrin.h>
+#define CONSTEXPR_CONTAINERS_X86 1
+#endif
+
+namespace constexpr_containers {
+
+// Hand vectorized kernels for the algorithms which compilers don't vectorize on their own.
+// These are runtime only, and pick the widest instruction set the CPU supports the first time
+// they're called (x86 only, everything else gets portable word-at-a-time versions).
+//
+// Synopsis:
+//
+// simd::has_avx2()
+//   Whether the CPU supports AVX2
+// simd::mismatch_bytes(a, b, size)
+//   The index of the first byte where a[0..size) and b[0..size) differ, size if there's none
+// simd::remove_equal(data, size, value)
+//   Packs the elements of data[0..size) which don't compare equal to value to the front, keeping
+//   their order, and returns how many there are, like std::remove followed by a subtraction.
+//   Branchless, and a whole vector at a time for 4 and 8 byte integers, float and double.
+// simd::vectorizable<Op>
+//   Only declared here, so that algorithms can tell it apart, see simd_transform.h
+
+namespace simd {
+
+template<typename Op>
+struct vectorizable;
+
+namespace detail {
+
+inline std::size_t
+mismatch_bytes_portable(const unsigned char* a, const unsigned char* b, std::size_t size) noexcept
+{
+  auto i = std::size_t(0);
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    std::uint64_t x;
+    std::uint64_t y;
+    std::memcpy(&x, a + i, sizeof(x));
+    std::memcpy(&y, b + i, sizeof(y));
+    if (x != y) {
+      break;
+    }
+  }
+  while (i < size and a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+#ifdef CONSTEXPR_CONTAINERS_X86
+
+__attribute__((target("sse2"))) inline std::size_t
+mismatch_bytes_sse2(const unsigned char* a, const unsigned char* b, std::size_t size) noexcept
+{
+  auto i = std::size_t(0);
+  for (; i + 16 <= size; i += 16) {
+    auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    auto y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    auto equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+    if (equal != 0xffff) {
+      return i + std::countr_one(equal);
+    }
+  }
+  return i + mismatch_bytes_portable(a + i, b + i, size - i);
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+mismatch_bytes_avx2(const unsigned char* a, const unsigned char* b, std::size_t size) noexcept
+{
+  auto i = std::size_t(0);
+  for (; i + 32 <= size; i += 32) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    auto equal = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    if (equal != 0xffffffff) {
+      return i + std::countr_one(equal);
+    }
+  }
+  return i + mismatch_bytes_sse2(a + i, b + i, size - i);
+}
+
+#endif
+
+// Returns a table with, for every mask of lanes to drop, the byte indices of the lanes to keep
+// packed to the front. Lanes are Parts bytes or elements wide, depending on the shuffle it's for.
+template<std::size_t Lanes, std::size_t Parts>
+constexpr auto
+make_compress_table() noexcept
+{
+  auto table = std::array<std::array<std::uint8_t, Lanes * Parts>, (1 << Lanes)>{};
+  for (std::size_t mask = 0; mask < table.size(); ++mask) {
+    auto kept = std::size_t(0);
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+      if (not(mask & (std::size_t(1) << lane))) {
+        for (std::size_t part = 0; part < Parts; ++part) {
+          table[mask][kept * Parts + part] = std::uint8_t(lane * Parts + part);
+        }
+        ++kept;
+      }
+    }
+  }
+  return table;
+}
+
+template<typename T>
+inline constexpr bool is_remove_equal_vectorizable_v =
+  (std::is_integral_v<T> or std::is_floating_point_v<T>) and (sizeof(T) == 4 or sizeof(T) == 8);
+
+// Stores every element instead of branching on the comparison, which mispredicts all the time
+// when the elements to remove are spread around. dst may equal src.
+template<typename T>
+T*
+remove_equal_portable(const T* src, const T* src_end, T* dst, T value) noexcept
+{
+  for (; src != src_end; ++src) {
+    auto elem = *src;
+    *dst = elem;
+    dst += not(elem == value);
+  }
+  return dst;
+}
+
+#ifdef CONSTEXPR_CONTAINERS_X86
+
+// pshufb controls for 16 byte vectors, and vpermd indices (widened from bytes) for 32 byte ones
+template<std::size_t VectorBytes, std::size_t ElementBytes>
+inline constexpr auto compress_table =
+  make_compress_table<VectorBytes / ElementBytes,
+                      VectorBytes == 16 ? ElementBytes : ElementBytes / 4>();
+
+// The bits of the lanes of x equal to value
+template<typename T>
+__attribute__((target("ssse3"))) inline unsigned
+equal_mask_ssse3(__m128i x, __m128i value) noexcept
+{
+  if constexpr (std::is_same_v<T, float>) {
+    return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(value))));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return unsigned(_mm_movemask_pd(_mm_cmpeq_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(value))));
+  } else if constexpr (sizeof(T) == 4) {
+    return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, value))));
+  } else {
+    // No 64 bit compare before SSE4.1, both halves have to be equal
+    auto halves = _mm_cmpeq_epi32(x, value);
+    auto both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, 0xb1));
+    return unsigned(_mm_movemask_pd(_mm_castsi128_pd(both)));
+  }
+}
+
+template<typename T>
+__attribute__((target("avx2"))) inline unsigned
+equal_mask_avx2(__m256i x, __m256i value) noexcept
+{
+  if constexpr (std::is_same_v<T, float>) {
+    auto eq = _mm256_cmp_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(value), _CMP_EQ_OQ);
+    return unsigned(_mm256_movemask_ps(eq));
+  } else if constexpr (std::is_same_v<T, double>) {
+    auto eq = _mm256_cmp_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(value), _CMP_EQ_OQ);
+    return unsigned(_mm256_movemask_pd(eq));
+  } else if constexpr (sizeof(T) == 4) {
+    return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, value))));
+  } else {
+    return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, value))));
+  }
+}
+
+// Each iteration stores a whole vector of kept lanes at dst, then only advances dst past the kept
+// ones. dst never gets ahead of src, so that only overwrites elements which were already loaded.
+template<typename T>
+__attribute__((target("ssse3"))) inline std::size_t
+remove_equal_ssse3(T* data, std::size_t size, T value) noexcept
+{
+  constexpr auto lanes = sizeof(__m128i) / sizeof(T);
+  const auto& table = compress_table<16, sizeof(T)>;
+  auto broadcast = _mm_setzero_si128();
+  if constexpr (sizeof(T) == 4) {
+    broadcast = _mm_set1_epi32(std::bit_cast<std::int32_t>(value));
+  } else {
+    broadcast = _mm_set1_epi64x(std::bit_cast<std::int64_t>(value));
+  }
+  auto dst = data;
+  auto i = std::size_t(0);
+  for (; i + lanes <= size; i += lanes) {
+    auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    auto mask = equal_mask_ssse3<T>(x, broadcast);
+    auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table[mask].data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(x, shuffle));
+    dst += lanes - std::size_t(std::popcount(mask));
+  }
+  return std::size_t(remove_equal_portable(data + i, data + size, dst, value) - data);
+}
+
+template<typename T>
+__attribute__((target("avx2"))) inline std::size_t
+remove_equal_avx2(T* data, std::size_t size, T value) noexcept
+{
+  constexpr auto lanes = sizeof(__m256i) / sizeof(T);
+  const auto& table = compress_table<32, sizeof(T)>;
+  auto broadcast = _mm256_setzero_si256();
+  if constexpr (sizeof(T) == 4) {
+    broadcast = _mm256_set1_epi32(std::bit_cast<std::int32_t>(value));
+  } else {
+    broadcast = _mm256_set1_epi64x(std::bit_cast<std::int64_t>(value));
+  }
+  auto dst = data;
+  auto i = std::size_t(0);
+  for (; i + lanes <= size; i += lanes) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    auto mask = equal_mask_avx2<T>(x, broadcast);
+    auto indices = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(table[mask].data()));
+    auto packed = _mm256_permutevar8x32_epi32(x, _mm256_cvtepu8_epi32(indices));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), packed);
+    dst += lanes - std::size_t(std::popcount(mask));
+  }
+  return std::size_t(remove_equal_portable(data + i, data + size, dst, value) - data);
+}
+
+#endif
+
+template<typename T>
+using remove_equal_fn = std::size_t (*)(T*, std::size_t, T) noexcept;
+
+template<typename T>
+std::size_t
+remove_equal_scalar(T* data, std::size_t size, T value) noexcept
+{
+  return std::size_t(remove_equal_portable(data, data + size, data, value) - data);
+}
+
+template<typename T>
+remove_equal_fn<T>
+select_remove_equal() noexcept
+{
+#ifdef CONSTEXPR_CONTAINERS_X86
+  if constexpr (is_remove_equal_vectorizable_v<T>) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return remove_equal_avx2<T>;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+      return remove_equal_ssse3<T>;
+    }
+  }
+#endif
+  return remove_equal_scalar<T>;
+}
+
+using mismatch_bytes_fn = std::size_t (*)(const unsigned char*,
+                                          const unsigned char*,
+                                          std::size_t) noexcept;
+
+template<typename Op>
+inline constexpr bool is_vectorizable_v = false;
+
+template<typename Op>
+inline constexpr bool is_vectorizable_v<vectorizable<Op>> = true;
+
+inline mismatch_bytes_fn
+select_mismatch_bytes() noexcept
+{
+#ifdef CONSTEXPR_CONTAINERS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return mismatch_bytes_avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return mismatch_bytes_sse2;
+  }
+#endif
+  return mismatch_bytes_portable;
+}
+
+} // namespace detail
+
+[[nodiscard]] inline bool
+has_avx2() noexcept
+{
+#ifdef CONSTEXPR_CONTAINERS_X86
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+[[nodiscard]] inline std::size_t
+mismatch_bytes(const void* a, const void* b, std::size_t size) noexcept
+{
+  static const auto fn = detail::select_mismatch_bytes();
+  return fn(static_cast<const unsigned char*>(a), static_cast<const unsigned char*>(b), size);
+}
+
+template<typename T>
+[[nodiscard]] std::size_t
+remove_equal(T* data, std::size_t size, T value) noexcept
+{
+  static_assert(std::is_arithmetic_v<T>);
+  static const auto fn = detail::select_remove_equal<T>();
+  return fn(data, size, value);
+}
+
+} // namespace simd
+
+} // namespace constexpr_containers
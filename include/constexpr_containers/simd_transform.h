@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <experimental/simd>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/simd.h"
+
+namespace constexpr_containers {
+
+// Lets zip_transform run an operation a whole std::experimental::native_simd at a time.
+//
+// This lives apart from simd.h, as <experimental/simd> takes a while to compile. It's always
+// included here, so the code every translation unit gets for a vectorizable is the same.
+//
+// Synopsis:
+//
+// simd::vectorizable{ op }
+//   Wraps an operation which also works on std::experimental::simd values, e.g.
+//   [](auto a, auto b) { return a * 2 + b; }. Calling it just calls op.
+//   op sees a whole simd of elements at once, so it mustn't depend on the order they're
+//   written in, e.g. by reading the destination through a reference it captured.
+// vectorizable.transform(count, dst, src...)
+//   Writes op(src[i]...) to dst[i], a whole native_simd at a time, for as many i as it can.
+//   Returns how many that was, a multiple of the simd width, which is 0 unless every src has the
+//   same arithmetic type as dst. Every src must either be dst or not overlap it.
+
+namespace simd {
+
+template<typename Op>
+struct vectorizable
+{
+  Op op;
+
+  template<typename... Args>
+  constexpr decltype(auto) operator()(Args&&... args) const
+  {
+    return op(std::forward<Args>(args)...);
+  }
+
+  template<typename T, typename... Ts>
+  std::size_t transform([[maybe_unused]] std::size_t count,
+                        [[maybe_unused]] T* dst,
+                        [[maybe_unused]] const Ts*... src) const //
+    noexcept(noexcept(op(*src...)))
+  {
+    if constexpr (std::is_arithmetic_v<T> and (std::is_same_v<T, Ts> and ...)) {
+      namespace stdx = std::experimental;
+      using V = stdx::native_simd<T>;
+      auto i = std::size_t(0);
+      for (; i + V::size() <= count; i += V::size()) {
+        V result = op(V(src + i, stdx::element_aligned)...);
+        result.copy_to(dst + i, stdx::element_aligned);
+      }
+      return i;
+    } else {
+      return 0;
+    }
+  }
+};
+
+template<typename Op>
+vectorizable(Op) -> vectorizable<Op>;
+
+} // namespace simd
+
+} // namespace constexpr_containers
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/allocator.h"
+#include "constexpr_containers/growth_policy.h"
+#include "constexpr_containers/stats_policy.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// An allocator with room for N elements inside of itself.
+//
+// The first allocation of at most N elements is served from the inline buffer,
+// everything else (including any allocation made while the inline buffer is in use)
+// is forwarded to Allocator. allocate_at_least always reports the full inline capacity,
+// so a vector_base using this allocator only spills to Allocator once it outgrows N elements.
+//
+// During constant evaluation the inline buffer can't be used (objects can only be
+// constructed in storage obtained from std::allocator), so everything goes to Allocator.
+//
+// Copies of an inline_allocator get their own (empty) buffer.
+// Two inline_allocators compare equal if neither buffer is in use and their Allocators are equal,
+// which lets vector_base steal heap buffers while moving inline elements one by one.
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>>
+struct inline_allocator
+{
+private:
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  template<typename, std::size_t, typename>
+  friend struct inline_allocator;
+
+public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using size_type = typename AllocTraitsT::size_type;
+  using difference_type = typename AllocTraitsT::difference_type;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  static_assert(std::is_same_v<typename AllocTraitsT::pointer, T*>,
+                "inline_allocator only supports allocators returning raw pointers");
+
+  template<typename U>
+  struct rebind
+  {
+    using other = inline_allocator<U, N, typename AllocTraitsT::template rebind_alloc<U>>;
+  };
+
+private:
+  alignas(T) std::byte m_storage[N * sizeof(T)];
+  bool m_in_use;
+  [[no_unique_address]] Allocator m_alloc;
+
+public:
+  constexpr inline_allocator() noexcept(noexcept(Allocator()))
+    : m_in_use(false)
+    , m_alloc()
+  {}
+
+  constexpr explicit inline_allocator(const Allocator& alloc) noexcept
+    : m_in_use(false)
+    , m_alloc(alloc)
+  {}
+
+  constexpr inline_allocator(const inline_allocator& other) noexcept
+    : m_in_use(false)
+    , m_alloc(other.m_alloc)
+  {}
+
+  template<typename U, typename OtherAllocator>
+  constexpr explicit inline_allocator(const inline_allocator<U, N, OtherAllocator>& other) noexcept
+    : m_in_use(false)
+    , m_alloc(other.m_alloc)
+  {}
+
+  // The inline buffer stays with this object, only the underlying allocator is assigned
+  constexpr //
+    inline_allocator&
+    operator=(const inline_allocator& other) noexcept
+  {
+    m_alloc = other.m_alloc;
+    return *this;
+  }
+
+  [[nodiscard]] constexpr //
+    inline_allocator
+    select_on_container_copy_construction() //
+    const
+  {
+    return inline_allocator(AllocTraitsT::select_on_container_copy_construction(m_alloc));
+  }
+
+  [[nodiscard]] constexpr //
+    allocation_result<T*, size_type>
+    allocate_at_least(size_type n)
+  {
+    if (not std::is_constant_evaluated() and not m_in_use and n <= N) {
+      m_in_use = true;
+      return { inline_buffer(), N };
+    }
+    return constexpr_containers::allocate_at_least(m_alloc, n);
+  }
+
+  [[nodiscard]] constexpr T* allocate(size_type n) { return allocate_at_least(n).ptr; }
+
+  constexpr //
+    void
+    deallocate(T* p, size_type n) //
+    noexcept
+  {
+    if (owns(p)) {
+      m_in_use = false;
+    } else {
+      AllocTraitsT::deallocate(m_alloc, p, n);
+    }
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    max_size() //
+    const noexcept
+  {
+    return AllocTraitsT::max_size(m_alloc);
+  }
+
+  // Whether p points into the inline buffer
+  [[nodiscard]] constexpr //
+    bool
+    owns(const T* p) //
+    const noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      return false;
+    }
+    auto less = std::less<const T*>();
+    return not less(p, inline_buffer()) and less(p, inline_buffer() + N);
+  }
+
+  [[nodiscard]] constexpr //
+    friend bool
+    operator==(const inline_allocator& a, const inline_allocator& b) //
+    noexcept
+  {
+    return &a == &b or (not a.m_in_use and not b.m_in_use and a.m_alloc == b.m_alloc);
+  }
+
+private:
+  [[nodiscard]] T* inline_buffer() noexcept { return reinterpret_cast<T*>(m_storage); }
+  [[nodiscard]] const T* inline_buffer() const noexcept
+  {
+    return reinterpret_cast<const T*>(m_storage);
+  }
+};
+
+// A vector which keeps its first N elements inside of itself, and only uses Allocator past that.
+//
+// All of the element logic is vector_base's, the inline storage lives in an inline_allocator.
+// Like std::vector, moving a small_vector whose elements are on the heap just steals the buffer,
+// but inline elements have to be moved one at a time.
+template<typename T,
+         std::size_t N,
+         typename Allocator = std::allocator<T>,
+         typename GrowthPolicy = growth::doubling,
+         typename StatsPolicy = stats::none>
+struct small_vector : vector_base<T, inline_allocator<T, N, Allocator>, GrowthPolicy, StatsPolicy>
+{
+private:
+  using base = vector_base<T, inline_allocator<T, N, Allocator>, GrowthPolicy, StatsPolicy>;
+
+public:
+  using typename base::allocator_type;
+  using typename base::size_type;
+
+  static constexpr size_type inline_capacity = N;
+
+  using base::base;
+
+  constexpr small_vector() noexcept = default;
+
+  constexpr small_vector(const small_vector& other)
+    : base(other)
+  {}
+
+  constexpr                            //
+    small_vector(small_vector&& other) //
+    noexcept(std::is_nothrow_move_constructible_v<T>)
+    : base(std::move(other), other.get_allocator())
+  {}
+
+  constexpr small_vector& operator=(const small_vector& other) = default;
+  constexpr small_vector& operator=(small_vector&& other) = default;
+
+  constexpr //
+    small_vector&
+    operator=(std::initializer_list<T> il)
+  {
+    base::operator=(il);
+    return *this;
+  }
+
+  // Whether the elements currently live inside of this object
+  [[nodiscard]] constexpr //
+    bool
+    is_inline() //
+    const noexcept
+  {
+    if (std::is_constant_evaluated() or this->data() == nullptr) {
+      return false;
+    }
+    auto less = std::less<const void*>();
+    return not less(this->data(), this) and less(this->data(), this + 1);
+  }
+
+  // vector_base::swap can't swap inline buffers, so those are swapped by moving
+  constexpr //
+    void
+    swap(small_vector& other)
+  {
+    if (not is_inline() and not other.is_inline()) {
+      base::swap(other);
+    } else {
+      auto tmp = std::move(other);
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+  friend constexpr void swap(small_vector& a, small_vector& b) { a.swap(b); }
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,739 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/launder_iterator.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Overflow policies decide what static_vector does when asked to hold more than N elements.
+//
+// An overflow policy is any type with a static constexpr bool checked,
+// and a static member function on_overflow() which is called (if checked) instead of overflowing.
+// on_overflow() isn't constexpr, so overflowing during constant evaluation is a compile error.
+//
+// Synopsis:
+//
+// overflow::throw_exception
+//   Throws std::length_error, the default
+// overflow::abort
+//   Calls std::abort, for code built without exceptions or which can't recover anyway
+// overflow::unchecked
+//   Doesn't check at all, overflowing is undefined behaviour
+
+namespace overflow {
+
+struct throw_exception
+{
+  static constexpr bool checked = true;
+
+  [[noreturn]] static void on_overflow()
+  {
+    throw std::length_error("static_vector capacity exceeded.");
+  }
+};
+
+struct abort
+{
+  static constexpr bool checked = true;
+
+  [[noreturn]] static void on_overflow() noexcept { std::abort(); }
+};
+
+struct unchecked
+{
+  static constexpr bool checked = false;
+
+  static constexpr void on_overflow() noexcept {}
+};
+
+} // namespace overflow
+
+namespace detail {
+
+// Lets the *_in_place algorithms, which keep an end pointer up to date, keep a size up to date
+// instead, whether they return or throw
+template<typename T>
+struct size_from_end
+{
+  T* first;
+  T* end;
+  std::size_t& size;
+
+  constexpr ~size_from_end() { size = static_cast<std::size_t>(end - first); }
+};
+
+// Trivially copyable types are kept in a plain array, so that static_vector is trivially copyable,
+// usable during constant evaluation, and can be returned out of it as a constant.
+template<typename T>
+inline constexpr bool static_vector_uses_array_v =
+  std::is_trivially_copyable_v<T> and std::is_default_constructible_v<T>;
+
+//
+// The array is in a union so that, at runtime, constructing an empty static_vector only sets
+// m_size, even when T has a non-trivial default constructor (e.g. default member initializers).
+template<typename T, std::size_t N, bool = static_vector_uses_array_v<T>>
+struct static_vector_storage
+{
+  union
+  {
+    T m_data[N];
+  };
+  std::size_t m_size;
+
+  constexpr static_vector_storage() noexcept(std::is_nothrow_default_constructible_v<T>)
+    : m_size(0)
+  {
+    // Every element of a constant has to be initialized, even the ones we don't use
+    if (std::is_constant_evaluated()) {
+      for (auto& elem : m_data) {
+        std::construct_at(&elem);
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr /****/ T* storage() /******/ noexcept { return m_data; }
+  [[nodiscard]] constexpr const T* storage() /**/ const noexcept { return m_data; }
+};
+
+// Everything else is kept in raw bytes, which can't be used during constant evaluation.
+template<typename T, std::size_t N>
+struct static_vector_storage<T, N, false>
+{
+  alignas(T) std::byte m_data[N * sizeof(T)];
+  std::size_t m_size;
+
+  static_vector_storage() noexcept
+    : m_size(0)
+  {}
+
+  static_vector_storage(const static_vector_storage& other) //
+    noexcept(std::is_nothrow_copy_constructible_v<T>)
+    : m_size(0)
+  {
+    uninitialized_copy_launder(other.storage(), other.storage() + other.m_size, storage(), alloc());
+    m_size = other.m_size;
+  }
+
+  static_vector_storage(static_vector_storage&& other) //
+    noexcept(std::is_nothrow_move_constructible_v<T>)
+    : m_size(0)
+  {
+    uninitialized_move_launder(other.storage(), other.storage() + other.m_size, storage(), alloc());
+    m_size = other.m_size;
+  }
+
+  static_vector_storage& operator=(const static_vector_storage& other)
+  {
+    if (this != &other) {
+      auto e = size_from_end<T>{ storage(), storage() + m_size, m_size };
+      assign_in_place(storage(), e.end, other.elements(), other.m_size, alloc());
+    }
+    return *this;
+  }
+
+  static_vector_storage& operator=(static_vector_storage&& other) //
+    noexcept(std::is_nothrow_move_assignable_v<T> and std::is_nothrow_move_constructible_v<T>)
+  {
+    if (this != &other) {
+      auto e = size_from_end<T>{ storage(), storage() + m_size, m_size };
+      auto src = std::make_move_iterator(other.elements());
+      assign_in_place(storage(), e.end, src, other.m_size, alloc());
+    }
+    return *this;
+  }
+
+  ~static_vector_storage() { destroy_launder(storage(), storage() + m_size, alloc()); }
+
+  [[nodiscard]] T* storage() noexcept { return reinterpret_cast<T*>(m_data); }
+  [[nodiscard]] const T* storage() const noexcept { return reinterpret_cast<const T*>(m_data); }
+
+private:
+  [[nodiscard]] static std::allocator<T> alloc() noexcept { return {}; }
+
+  // The elements live in raw bytes, so they have to be laundered
+  [[nodiscard]] launder_iterator<T> elements() noexcept { return storage(); }
+  [[nodiscard]] launder_iterator<const T> elements() const noexcept { return storage(); }
+};
+
+} // namespace detail
+
+// A vector with room for N elements inside of itself, and no allocator at all.
+//
+// For trivially copyable T, a static_vector is itself trivially copyable,
+// can be used during constant evaluation, and can be returned from a constant expression:
+//
+//   constexpr auto primes = [] {
+//     static_vector<int, 16> v;
+//     for (int i = 2; v.size() < v.capacity(); ++i) {
+//       if (std::none_of(v.begin(), v.end(), [&](int p) { return i % p == 0; })) {
+//         v.push_back(i);
+//       }
+//     }
+//     return v;
+//   }();
+//
+// which a vector_base can't do, as its heap allocation can't outlive constant evaluation.
+// Other types are stored in raw bytes, and can only be used at runtime.
+//
+// Growing past N elements is handled by OverflowPolicy.
+template<typename T, std::size_t N, typename OverflowPolicy = overflow::throw_exception>
+struct static_vector
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Never actually allocates, only used to construct and destroy elements
+  using AllocatorT = std::allocator<T>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using reverse_const_iterator = std::reverse_iterator<const_iterator>;
+  using comparison_type = typename detail::comparison_type<T>::type;
+  using overflow_policy = OverflowPolicy;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+private:
+  detail::static_vector_storage<T, N> m_storage;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr static_vector() noexcept = default;
+
+  constexpr //
+    static_vector(size_type count, const T& value)
+  {
+    check_capacity(count);
+    m_storage.m_size =
+      uninitialized_construct(begin(), begin() + count, AllocatorT(), value) - begin();
+  }
+
+  constexpr explicit //
+    static_vector(size_type count)
+  {
+    check_capacity(count);
+    m_storage.m_size = uninitialized_construct(begin(), begin() + count, AllocatorT()) - begin();
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    static_vector(InputIt first, InputIt last)
+  {
+    for (const auto& elem : make_range(first, last)) {
+      push_back(elem);
+    }
+  }
+
+  template<std::random_access_iterator RandomAccessIt>
+  constexpr //
+    static_vector(RandomAccessIt first, RandomAccessIt last)
+  {
+    check_capacity(last - first);
+    m_storage.m_size = uninitialized_copy(first, last, begin(), AllocatorT()) - begin();
+  }
+
+  constexpr static_vector(std::initializer_list<T> il)
+    : static_vector(il.begin(), il.end())
+  {}
+
+  constexpr //
+    static_vector&
+    operator=(std::initializer_list<T> il)
+  {
+    check_capacity(il.size());
+    auto e = in_place();
+    assign_in_place(begin(), e.end, il.begin(), il.size(), alloc());
+    return *this;
+  }
+
+  constexpr //
+    void
+    swap(static_vector& other) //
+    noexcept(std::is_nothrow_swappable_v<T> and std::is_nothrow_move_constructible_v<T>)
+  {
+    auto& shorter = size() < other.size() ? *this : other;
+    auto& longer = size() < other.size() ? other : *this;
+    std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+    auto common = shorter.size();
+    auto shorter_end =
+      uninitialized_move_launder(longer.begin() + common, longer.end(), shorter.end(), alloc());
+    shorter.m_storage.m_size = shorter_end - shorter.begin();
+    longer.truncate(longer.begin() + common);
+  }
+
+  friend constexpr //
+    void
+    swap(static_vector& a, static_vector& b) //
+    noexcept(noexcept(a.swap(b)))
+  {
+    a.swap(b);
+  }
+
+private:
+  constexpr //
+    void
+    check_range(size_type n) //
+    const
+  {
+    if (n >= size()) {
+      throw std::out_of_range("Bounds check failed.");
+    }
+  }
+
+  static constexpr //
+    void
+    check_capacity(size_type n)
+  {
+    if constexpr (OverflowPolicy::checked) {
+      if (n > N) {
+        OverflowPolicy::on_overflow();
+      }
+    }
+  }
+
+public:
+  [[nodiscard]] constexpr //
+    reference
+    at(size_type pos)
+  {
+    check_range(pos);
+    return (*this)[pos];
+  }
+  [[nodiscard]] constexpr //
+    const_reference
+    at(size_type pos) //
+    const
+  {
+    check_range(pos);
+    return (*this)[pos];
+  }
+
+  [[nodiscard]] constexpr //
+    reference
+    operator[](size_type pos) //
+    noexcept
+  {
+    return *maybe_launder(begin() + pos);
+  }
+  [[nodiscard]] constexpr //
+    const_reference
+    operator[](size_type pos) //
+    const noexcept
+  {
+    return *maybe_launder(begin() + pos);
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr /********/ pointer data() /**/ noexcept { return m_storage.storage(); }
+  [[nodiscard]] constexpr const_pointer data() const noexcept { return m_storage.storage(); }
+
+  [[nodiscard]] constexpr /***/ reference front() /********/ noexcept { return *begin(); }
+  [[nodiscard]] constexpr const_reference front() /**/ const noexcept { return *begin(); }
+  [[nodiscard]] constexpr /***/ reference back() /*********/ noexcept { return *(end() - 1); }
+  [[nodiscard]] constexpr const_reference back() /***/ const noexcept { return *(end() - 1); }
+
+  [[nodiscard]] constexpr /***/ iterator begin() /*********/ noexcept { return data(); }
+  [[nodiscard]] constexpr const_iterator begin() /***/ const noexcept { return data(); }
+  [[nodiscard]] constexpr /***/ iterator end() /***********/ noexcept { return data() + size(); }
+  [[nodiscard]] constexpr const_iterator end() /*****/ const noexcept { return data() + size(); }
+  [[nodiscard]] constexpr const_iterator cbegin() /**/ const noexcept { return begin(); }
+  [[nodiscard]] constexpr const_iterator cend() /****/ const noexcept { return end(); }
+
+  [[nodiscard]] constexpr //
+    reverse_iterator
+    rbegin() //
+    noexcept
+  {
+    return reverse_iterator(end());
+  }
+  [[nodiscard]] constexpr //
+    reverse_const_iterator
+    rbegin() //
+    const noexcept
+  {
+    return reverse_const_iterator(end());
+  }
+  [[nodiscard]] constexpr //
+    reverse_iterator
+    rend() //
+    noexcept
+  {
+    return reverse_iterator(begin());
+  }
+  [[nodiscard]] constexpr //
+    reverse_const_iterator
+    rend() //
+    const noexcept
+  {
+    return reverse_const_iterator(begin());
+  }
+  [[nodiscard]] constexpr reverse_const_iterator crbegin() /**/ const noexcept { return rbegin(); }
+  [[nodiscard]] constexpr reverse_const_iterator crend() /****/ const noexcept { return rend(); }
+
+  [[nodiscard]] constexpr size_type size() /*********/ const noexcept { return m_storage.m_size; }
+  [[nodiscard]] static constexpr size_type capacity() /********/ noexcept { return N; }
+  [[nodiscard]] static constexpr size_type max_size() /********/ noexcept { return N; }
+  [[nodiscard]] constexpr bool empty() /****************/ const noexcept { return size() == 0; }
+  [[nodiscard]] constexpr bool full() /*****************/ const noexcept { return size() == N; }
+
+  ////////////////////
+  // Size modifiers //
+  ////////////////////
+
+  // There's nothing to allocate, so this just checks that new_cap fits
+  static constexpr void reserve(size_type new_cap) { check_capacity(new_cap); }
+  static constexpr void shrink_to_fit() noexcept {}
+
+  constexpr //
+    void
+    resize(size_type count)
+  {
+    check_capacity(count);
+    if (count > size()) {
+      m_storage.m_size = uninitialized_construct(end(), begin() + count, AllocatorT()) - begin();
+    } else {
+      truncate(begin() + count);
+    }
+  }
+
+  constexpr //
+    void
+    resize(size_type count, const value_type& value)
+  {
+    check_capacity(count);
+    if (count > size()) {
+      m_storage.m_size =
+        uninitialized_construct(end(), begin() + count, AllocatorT(), value) - begin();
+    } else {
+      truncate(begin() + count);
+    }
+  }
+
+  // See vector_base::resize_for_overwrite
+  constexpr //
+    void
+    resize_for_overwrite(size_type count)
+  {
+    check_capacity(count);
+    if (count > size()) {
+      m_storage.m_size = uninitialized_default_construct(end(), begin() + count, alloc()) - begin();
+    } else {
+      truncate(begin() + count);
+    }
+  }
+
+  // See vector_base::resize_and_overwrite
+  template<typename Operation>
+  constexpr //
+    void
+    resize_and_overwrite(size_type count, Operation op)
+  {
+    auto oldsize = size();
+    if (count > oldsize) {
+      resize_for_overwrite(count);
+    }
+    try {
+      auto new_size = static_cast<size_type>(std::move(op)(begin(), count));
+      truncate(begin() + new_size);
+    } catch (...) {
+      truncate(begin() + std::min(oldsize, size()));
+      throw;
+    }
+  }
+
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    truncate(begin());
+  }
+
+  /////////////////////////
+  // Insertion modifiers //
+  /////////////////////////
+
+  // Strong exception guarantee
+  template<typename... Args>
+  constexpr //
+    reference
+    emplace_back(Args&&... args)
+  {
+    check_capacity(size() + 1);
+    auto a = alloc();
+    std::allocator_traits<AllocatorT>::construct(a, end(), std::forward<Args>(args)...);
+    ++m_storage.m_size;
+    return back();
+  }
+
+  // Strong exception guarantee
+  constexpr void push_back(const T& v) { emplace_back(v); }
+  // Strong exception guarantee
+  constexpr void push_back(T&& v) { emplace_back(std::move(v)); }
+
+  template<typename... Args>
+  constexpr //
+    iterator
+    emplace(const_iterator pos, Args&&... args)
+  {
+    auto p = begin() + (pos - begin());
+    if (p == end()) {
+      emplace_back(std::forward<Args>(args)...);
+      return p;
+    }
+    check_capacity(size() + 1);
+    // Construct first in case args refer to an element, then shift everything back
+    auto tmp = T(std::forward<Args>(args)...);
+    auto e = in_place();
+    insert_one_in_place(p, e.end, std::move_if_noexcept(tmp), alloc());
+    return p;
+  }
+
+  constexpr //
+    iterator
+    insert(const_iterator pos, const T& value)
+  {
+    return emplace(pos, value);
+  }
+
+  constexpr //
+    iterator
+    insert(const_iterator pos, T&& value)
+  {
+    check_capacity(size() + 1);
+    auto p = begin() + (pos - begin());
+    auto e = in_place();
+    insert_one_in_place(p, e.end, std::move(value), alloc());
+    return p;
+  }
+
+  constexpr //
+    iterator
+    insert(const_iterator pos, size_type count, const T& value)
+  {
+    check_capacity(size() + count);
+    auto p = begin() + (pos - begin());
+    if (count == 0) {
+      return p;
+    }
+    // Copy value first in case it is one of the elements
+    auto tmp = T(value);
+    auto e = in_place();
+    insert_fill_in_place(p, e.end, count, tmp, alloc());
+    return p;
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    iterator
+    insert(const_iterator pos, InputIt first, InputIt last)
+  {
+    return insert_range(pos, std::ranges::subrange(first, last));
+  }
+
+  constexpr //
+    iterator
+    insert(const_iterator pos, std::initializer_list<T> ilist)
+  {
+    return insert(pos, ilist.begin(), ilist.end());
+  }
+
+  // Like C++23's std::vector::insert_range.
+  // Forward ranges shift the tail only once. There's nowhere to buffer input ranges, so they are
+  // appended and then rotated into place.
+  template<std::ranges::input_range R>
+  constexpr //
+    iterator
+    insert_range(const_iterator pos, R&& rg)
+  {
+    auto p = begin() + (pos - begin());
+    if constexpr (std::ranges::forward_range<R>) {
+      auto count = static_cast<size_type>(std::ranges::distance(rg));
+      check_capacity(size() + count);
+      auto e = in_place();
+      insert_copy_in_place(p, e.end, std::ranges::begin(rg), count, alloc());
+    } else {
+      auto old_end = end();
+      append_range(std::forward<R>(rg));
+      std::rotate(p, old_end, end());
+    }
+    return p;
+  }
+
+  // Like C++23's std::vector::append_range
+  template<std::ranges::input_range R>
+  constexpr //
+    void
+    append_range(R&& rg)
+  {
+    if constexpr (std::ranges::forward_range<R>) {
+      insert_range(end(), std::forward<R>(rg));
+    } else {
+      if constexpr (std::ranges::sized_range<R>) {
+        check_capacity(size() + std::ranges::size(rg));
+      }
+      for (auto it = std::ranges::begin(rg); it != std::ranges::end(rg); ++it) {
+        emplace_back(*it);
+      }
+    }
+  }
+
+  ///////////////////////
+  // Removal modifiers //
+  ///////////////////////
+
+  constexpr //
+    void
+    pop_back() //
+  {
+    truncate(end() - 1);
+  }
+
+  constexpr //
+    iterator
+    erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  constexpr //
+    iterator
+    erase(const_iterator first, const_iterator last)
+  {
+    auto p = begin() + (first - begin());
+    auto e = in_place();
+    erase_in_place(p, begin() + (last - begin()), e.end, alloc());
+    return p;
+  }
+
+  // See vector_base::erase_if
+  template<typename Pred>
+  constexpr //
+    size_type
+    erase_if(Pred pred)
+  {
+    auto e = in_place();
+    return erase_if_in_place(begin(), e.end, pred, alloc());
+  }
+
+  // See vector_base::unordered_erase
+  constexpr //
+    iterator
+    unordered_erase(const_iterator pos)
+  {
+    auto p = begin() + (pos - begin());
+    if (p != end() - 1) {
+      *maybe_launder(p) = std::move(*maybe_launder(end() - 1));
+    }
+    pop_back();
+    return p;
+  }
+
+  // See vector_base::unordered_erase_if
+  template<typename Pred>
+  constexpr //
+    size_type
+    unordered_erase_if(Pred pred)
+  {
+    auto e = in_place();
+    return unordered_erase_if_in_place(begin(), e.end, pred, alloc());
+  }
+
+  //////////////////////////
+  // Comparison operators //
+  //////////////////////////
+
+  [[nodiscard]] constexpr //
+    bool
+    operator==(const static_vector& other)               //
+    const noexcept(noexcept(*begin() == *other.begin())) //
+    requires std::equality_comparable<T>
+  {
+    return constexpr_containers::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  [[nodiscard]] constexpr //
+    comparison_type
+    operator<=>(const static_vector& other)              //
+    const noexcept(noexcept(*begin() == *other.begin())) //
+    requires std::three_way_comparable<T> ||             //
+    requires(const T& elem)
+  {
+    elem < elem;
+  } //
+  {
+    return constexpr_containers::lexicographical_compare_three_way(
+      begin(), end(), other.begin(), other.end());
+  }
+
+private:
+  [[nodiscard]] static constexpr AllocatorT alloc() noexcept { return {}; }
+
+  // For the *_in_place algorithms: its end is the end of the elements, and the size follows it
+  [[nodiscard]] constexpr //
+    detail::size_from_end<T>
+    in_place() //
+    noexcept
+  {
+    return { data(), data() + size(), m_storage.m_size };
+  }
+
+  constexpr //
+    void
+    truncate(pointer new_end) //
+    noexcept
+  {
+    destroy_launder(new_end, end(), alloc());
+    m_storage.m_size = new_end - begin();
+  }
+};
+
+template<typename T, std::size_t N, typename Policy, typename U>
+constexpr //
+  typename static_vector<T, N, Policy>::size_type
+  erase(static_vector<T, N, Policy>& c, const U& value)
+{
+  return detail::erase_value<T>(c, value);
+}
+
+template<typename T, std::size_t N, typename Policy, typename Pred>
+constexpr //
+  typename static_vector<T, N, Policy>::size_type
+  erase_if(static_vector<T, N, Policy>& c, Pred pred)
+{
+  return c.erase_if(std::move(pred));
+}
+
+} // namespace constexpr_containers
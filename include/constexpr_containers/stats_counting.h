@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "constexpr_containers/stats_policy.h"
+
+namespace constexpr_containers {
+
+// A stats policy (see stats_policy.h) which counts what vector_base's buffers do, and a registry
+// of every group of vectors being counted.
+//
+// Synopsis:
+//
+// stats::counting<Tag>
+//   Adds everything up in a stats::counters shared by every vector_base using counting<Tag>.
+//   Use a different Tag for each group of vectors you want to tell apart, e.g. the element type.
+//   Calls made during constant evaluation aren't counted.
+// stats::counters
+//   Allocations, deallocations, reallocations (relocating growth or shrinking), in place
+//   expansions, elements and bytes relocated, the largest capacity ever allocated or expanded
+//   to, and the total capacity which was never used by the time its buffer was freed.
+// stats::registry()
+//   Every counting<Tag> which has been used so far, along with its name
+//   (Tag::name if it has one, typeid(Tag).name() otherwise).
+// stats::dump(file)
+//   Prints every entry of the registry.
+
+namespace stats {
+
+struct counters
+{
+  std::atomic<std::size_t> allocations{ 0 };
+  std::atomic<std::size_t> deallocations{ 0 };
+  std::atomic<std::size_t> reallocations{ 0 };
+  std::atomic<std::size_t> expansions{ 0 };
+  std::atomic<std::size_t> relocated_elements{ 0 };
+  std::atomic<std::size_t> relocated_bytes{ 0 };
+  std::atomic<std::size_t> peak_capacity{ 0 };
+  std::atomic<std::size_t> slack_elements{ 0 };
+  std::atomic<std::size_t> slack_bytes{ 0 };
+};
+
+struct registry_entry
+{
+  const char* name;
+  const counters* stats;
+};
+
+namespace detail {
+
+inline std::mutex&
+registry_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+inline std::vector<registry_entry>&
+registry_entries()
+{
+  static std::vector<registry_entry> entries;
+  return entries;
+}
+
+template<typename Tag>
+const char*
+tag_name()
+{
+  if constexpr (requires { Tag::name; }) {
+    return Tag::name;
+  } else {
+    return typeid(Tag).name();
+  }
+}
+
+inline bool
+register_counters(const char* name, const counters* stats)
+{
+  auto lock = std::lock_guard(registry_mutex());
+  registry_entries().push_back({ name, stats });
+  return true;
+}
+
+} // namespace detail
+
+// A snapshot, as counters may register from other threads
+inline std::vector<registry_entry>
+registry()
+{
+  auto lock = std::lock_guard(detail::registry_mutex());
+  return detail::registry_entries();
+}
+
+template<typename Tag = void>
+struct counting
+{
+private:
+  static inline counters m_counters;
+  // Referenced by every hook, so that only tags which are actually used get registered
+  static inline const bool m_registered =
+    detail::register_counters(detail::tag_name<Tag>(), &m_counters);
+
+  static void add(std::atomic<std::size_t>& counter, std::size_t n) noexcept
+  {
+    static_cast<void>(m_registered);
+    counter.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  static void raise(std::atomic<std::size_t>& counter, std::size_t n) noexcept
+  {
+    auto old = counter.load(std::memory_order_relaxed);
+    while (old < n and not counter.compare_exchange_weak(old, n, std::memory_order_relaxed)) {
+    }
+  }
+
+public:
+  [[nodiscard]] static const counters& get() noexcept { return m_counters; }
+
+  static constexpr void on_allocate(std::size_t count, std::size_t /*element_size*/) noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      return;
+    }
+    add(m_counters.allocations, 1);
+    raise(m_counters.peak_capacity, count);
+  }
+
+  static constexpr void on_deallocate(std::size_t count,
+                                      std::size_t used,
+                                      std::size_t element_size) noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      return;
+    }
+    add(m_counters.deallocations, 1);
+    add(m_counters.slack_elements, count - used);
+    add(m_counters.slack_bytes, (count - used) * element_size);
+  }
+
+  static constexpr void on_relocate(std::size_t count, std::size_t element_size) noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      return;
+    }
+    add(m_counters.reallocations, 1);
+    add(m_counters.relocated_elements, count);
+    add(m_counters.relocated_bytes, count * element_size);
+  }
+
+  static constexpr void on_expand(std::size_t /*old_count*/,
+                                  std::size_t new_count,
+                                  std::size_t /*element_size*/) noexcept
+  {
+    if (std::is_constant_evaluated()) {
+      return;
+    }
+    add(m_counters.expansions, 1);
+    raise(m_counters.peak_capacity, new_count);
+  }
+};
+
+inline void
+dump(std::FILE* file = stderr)
+{
+  for (const auto& entry : registry()) {
+    const auto& c = *entry.stats;
+    std::fprintf(file,
+                 "%s: %zu allocations, %zu deallocations, %zu reallocations, %zu expansions, "
+                 "%zu elements (%zu bytes) relocated, %zu peak capacity, "
+                 "%zu elements (%zu bytes) of slack\n",
+                 entry.name,
+                 c.allocations.load(std::memory_order_relaxed),
+                 c.deallocations.load(std::memory_order_relaxed),
+                 c.reallocations.load(std::memory_order_relaxed),
+                 c.expansions.load(std::memory_order_relaxed),
+                 c.relocated_elements.load(std::memory_order_relaxed),
+                 c.relocated_bytes.load(std::memory_order_relaxed),
+                 c.peak_capacity.load(std::memory_order_relaxed),
+                 c.slack_elements.load(std::memory_order_relaxed),
+                 c.slack_bytes.load(std::memory_order_relaxed));
+  }
+}
+
+} // namespace stats
+
+} // namespace constexpr_containers
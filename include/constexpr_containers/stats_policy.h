@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+namespace constexpr_containers {
+
+// Stats policies let vector_base report what its buffers are doing.
+//
+// A stats policy is any type with the static member functions
+//
+//   static constexpr void on_allocate(std::size_t count, std::size_t element_size);
+//   static constexpr void on_deallocate(std::size_t count, std::size_t used,
+//                                       std::size_t element_size);
+//   static constexpr void on_relocate(std::size_t count, std::size_t element_size);
+//   static constexpr void on_expand(std::size_t old_count, std::size_t new_count,
+//                                   std::size_t element_size);
+//
+// which are called with element counts (not bytes) whenever vector_base gets a buffer of count
+// elements, frees one (which was holding used elements at the time), moves count elements into
+// a new buffer while growing or shrinking, or expands its buffer in place (see try_expand).
+//
+// Synopsis:
+//
+// stats::none
+//   Does nothing, the default. Every call compiles away.
+//
+// A policy which actually counts, stats::counting, is in stats_counting.h, so that vectors which
+// don't use it don't pay for its includes.
+
+namespace stats {
+
+struct none
+{
+  static constexpr void on_allocate(std::size_t /*count*/, std::size_t /*element_size*/) noexcept {}
+  static constexpr void on_deallocate(std::size_t /*count*/,
+                                      std::size_t /*used*/,
+                                      std::size_t /*element_size*/) noexcept
+  {}
+  static constexpr void on_relocate(std::size_t /*count*/, std::size_t /*element_size*/) noexcept {}
+  static constexpr void on_expand(std::size_t /*old_count*/,
+                                  std::size_t /*new_count*/,
+                                  std::size_t /*element_size*/) noexcept
+  {}
+};
+
+} // namespace stats
+
+} // namespace constexpr_containers
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace constexpr_containers {
+
+// Contains type traits useful for container classes.
+//
+// Synopsis:
+//
+// is_trivially_relocatable<T>
+//   Whether an object of type T can be moved to a new address by copying its bytes,
+//   skipping both the move constructor at the destination and the destructor at the source.
+//   Defaults to std::is_trivially_copyable, specialize it to opt in other types.
+// allocator_has_trivial_construct_v<Allocator, T>
+//   Whether allocator_traits<Allocator>::construct for T is known to be a plain placement new
+// allocator_has_trivial_destroy_v<Allocator, T>
+//   Whether allocator_traits<Allocator>::destroy for T is known to be a plain destructor call
+// is_memcpy_relocatable_v<T, Allocator>
+//   Whether elements of a container of T using Allocator may be relocated with memcpy
+// needs_launder<T>
+//   Whether pointers to a T must be passed through std::launder to reach an object which was
+//   constructed where another one used to live. Conservatively true, except for types which
+//   provably have no const or reference members. Specialize it to opt other types out.
+
+// Types which own a resource but never point into themselves (e.g. unique_ptr-like handles)
+// are usually trivially relocatable even though they aren't trivially copyable. Opt them in with:
+//
+//   template<>
+//   struct constexpr_containers::is_trivially_relocatable<my_handle> : std::true_type
+//   {};
+//
+// Strictly speaking, the standard only blesses memcpy for trivially copyable types,
+// so opting in is a promise that your compiler won't mind either.
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Only const objects and objects with const or reference members can't be transparently replaced
+// (see the README). Members like these delete the implicit copy and move assignment operators,
+// so a trivial assignment operator rules them out, all the way down.
+template<typename T>
+struct needs_launder
+  : std::bool_constant<std::is_const_v<T> or
+                       not(std::is_scalar_v<T> or std::is_trivially_copy_assignable_v<T> or
+                           std::is_trivially_move_assignable_v<T>)>
+{};
+
+template<typename T>
+inline constexpr bool needs_launder_v = needs_launder<T>::value;
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_pair_v = false;
+
+template<typename T, typename U>
+inline constexpr bool is_pair_v<std::pair<T, U>> = true;
+
+template<typename Allocator>
+inline constexpr bool is_polymorphic_allocator_v = false;
+
+template<typename U>
+inline constexpr bool is_polymorphic_allocator_v<std::pmr::polymorphic_allocator<U>> = true;
+
+} // namespace detail
+
+// An allocator with no construct member falls back to std::construct_at.
+// polymorphic_allocator::construct only does something special for allocator-aware types.
+template<typename Allocator, typename T>
+inline constexpr bool allocator_has_trivial_construct_v =
+  detail::is_polymorphic_allocator_v<Allocator> ?
+    not std::uses_allocator_v<T, Allocator> and not detail::is_pair_v<T> :
+    not requires(Allocator& alloc, T* p, T&& value) { alloc.construct(p, std::move(value)); } and
+      not requires(Allocator& alloc, T* p, const T& value) { alloc.construct(p, value); };
+
+// An allocator with no destroy member falls back to std::destroy_at.
+// polymorphic_allocator::destroy (deprecated) is exactly std::destroy_at.
+template<typename Allocator, typename T>
+inline constexpr bool allocator_has_trivial_destroy_v =
+  detail::is_polymorphic_allocator_v<Allocator> or
+  not requires(Allocator& alloc, T* p) { alloc.destroy(p); };
+
+template<typename T, typename Allocator>
+inline constexpr bool is_memcpy_relocatable_v = is_trivially_relocatable_v<T> and
+                                                allocator_has_trivial_construct_v<Allocator, T> and
+                                                allocator_has_trivial_destroy_v<Allocator, T>;
+
+} // namespace constexpr_containers
@@ -3,17 +3,23 @@
 #include <memory>          // for allocator
 #include <memory_resource> // for polymorphic_allocator
 
+#include "constexpr_containers/growth_policy.h"
+#include "constexpr_containers/stats_policy.h"
 #include "constexpr_containers/vector_base.h"
 
 namespace constexpr_containers {
 
-template<typename T, typename Allocator = std::allocator<T>>
-using vector = vector_base<T, Allocator>;
+template<typename T,
+         typename Allocator = std::allocator<T>,
+         typename GrowthPolicy = growth::doubling,
+         typename StatsPolicy = stats::none>
+using vector = vector_base<T, Allocator, GrowthPolicy, StatsPolicy>;
 
 namespace pmr {
 
-template<typename T>
-using vector = ::constexpr_containers::vector_base<T, std::pmr::polymorphic_allocator<T>>;
+template<typename T, typename GrowthPolicy = growth::doubling, typename StatsPolicy = stats::none>
+using vector = ::constexpr_containers::
+  vector_base<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy, StatsPolicy>;
 
 } // namespace pmr
 
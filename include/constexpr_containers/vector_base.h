@@ -7,15 +7,41 @@
 #include <limits>
 #include <memory>
 #include <new>
+#include <ranges>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 #include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/allocator.h"
+#include "constexpr_containers/growth_policy.h"
+#include "constexpr_containers/launder_iterator.h"
+#include "constexpr_containers/simd.h"
+#include "constexpr_containers/stats_policy.h"
+#include "constexpr_containers/type_traits.h"
 
 namespace constexpr_containers {
 
-template<typename T, typename Allocator>
+namespace detail {
+
+template<typename T>
+struct comparison_type
+{
+  using type = std::weak_ordering;
+};
+
+template<std::three_way_comparable T>
+struct comparison_type<T>
+{
+  using type = std::compare_three_way_result_t<T>;
+};
+
+} // namespace detail
+
+template<typename T,
+         typename Allocator,
+         typename GrowthPolicy = growth::doubling,
+         typename StatsPolicy = stats::none>
 struct vector_base
 {
   //////////////////
@@ -29,19 +55,21 @@ private:
 public:
   using value_type = T;
   using allocator_type = Allocator;
+  using growth_policy = GrowthPolicy;
+  using stats_policy = StatsPolicy;
   using size_type = typename AllocTraitsT::size_type;
   using difference_type = typename AllocTraitsT::difference_type;
   using reference = T&;
   using const_reference = const T&;
   using pointer = typename AllocTraitsT::pointer;
   using const_pointer = typename AllocTraitsT::const_pointer;
-  using iterator = pointer;
-  using const_iterator = const_pointer;
+  // Plain pointers unless the elements may need laundering, see launder_iterator.h
+  using iterator = std::conditional_t<needs_launder_v<T>, launder_iterator<T>, pointer>;
+  using const_iterator =
+    std::conditional_t<needs_launder_v<T>, launder_iterator<const T>, const_pointer>;
   using reverse_iterator = std::reverse_iterator<iterator>;
   using reverse_const_iterator = std::reverse_iterator<const_iterator>;
-  using comparison_type = std::conditional_t<std::three_way_comparable<T>,
-                                             decltype(std::declval<T>() <=> std::declval<T>()),
-                                             std::weak_ordering>;
+  using comparison_type = typename detail::comparison_type<T>::type;
 
   /////////////////
   // Data layout //
@@ -80,10 +108,12 @@ public:
     : m_alloc(alloc)
   {
     allocate(count, m_alloc);
-    for (auto& elem : make_range(m_begin, m_realend)) {
-      AllocTraitsT::construct(m_alloc, std::launder(&elem), value);
+    try {
+      m_end = uninitialized_construct(m_begin, m_begin + count, m_alloc, value);
+    } catch (...) {
+      free_buffer(m_begin, capacity(), 0);
+      throw;
     }
-    m_end = m_realend;
   }
 
   constexpr explicit //
@@ -91,10 +121,12 @@ public:
     : m_alloc(alloc)
   {
     allocate(count, m_alloc);
-    for (auto& elem : make_range(m_begin, m_realend)) {
-      AllocTraitsT::construct(m_alloc, std::launder(&elem));
+    try {
+      m_end = uninitialized_construct(m_begin, m_begin + count, m_alloc);
+    } catch (...) {
+      free_buffer(m_begin, capacity(), 0);
+      throw;
     }
-    m_end = m_realend;
   }
 
   // Looser overload that allows any input iterator
@@ -112,14 +144,20 @@ public:
   }
 
   // Tighter overload to reserve up front
-  template<std::random_access_iterator RandomAccessIt>
+  template<std::forward_iterator ForwardIt>
   constexpr //
-    vector_base(RandomAccessIt first, RandomAccessIt last, const Allocator& alloc = Allocator())
+    vector_base(ForwardIt first, ForwardIt last, const Allocator& alloc = Allocator())
     : m_alloc(alloc)
   {
-    if (last - first > 0) {
-      allocate(last - first, m_alloc);
-      m_end = uninitialized_copy(first, last, m_begin, m_alloc);
+    auto count = static_cast<size_type>(std::distance(first, last));
+    if (count > 0) {
+      allocate(count, m_alloc);
+      try {
+        m_end = uninitialized_copy(first, last, m_begin, m_alloc);
+      } catch (...) {
+        free_buffer(m_begin, capacity(), 0);
+        throw;
+      }
     } else {
       m_begin = m_end = m_realend = nullptr;
     }
@@ -161,9 +199,17 @@ public:
     : m_alloc(alloc)
   {
     if (m_alloc != other.m_alloc) {
-      allocate(other.size());
-      uninitialized_move(other.m_begin, other.m_end, m_begin, m_alloc);
-      m_end = m_realend;
+      if (other.empty()) {
+        m_begin = m_end = m_realend = nullptr;
+        return;
+      }
+      allocate(other.size(), m_alloc);
+      try {
+        m_end = uninitialized_move_launder(other.m_begin, other.m_end, m_begin, m_alloc);
+      } catch (...) {
+        free_buffer(m_begin, capacity(), 0);
+        throw;
+      }
     } else {
       m_begin = other.m_begin;
       m_end = other.m_end;
@@ -180,44 +226,30 @@ public:
     if (this != &other) {
       if constexpr (AllocTraitsT::propagate_on_container_copy_assignment::value) {
         if (not AllocTraitsT::is_always_equal::value and m_alloc != other.m_alloc) {
+          // our buffer can only be freed by our old allocator
           deallocate();
+          m_begin = m_end = m_realend = nullptr;
         }
-        allocate_empty(other.size());
         m_alloc = other.m_alloc;
       }
 
       // we require realloc, so we construct into fresh array directly
       if (other.size() > capacity()) {
-        auto tmp = allocate_tmp(other.size(), m_alloc);
+        auto [tmp, tmp_cap] = allocate_tmp(other.size(), m_alloc);
         try {
-          uninitialized_copy(other.m_begin, other.m_end, tmp, m_alloc);
+          uninitialized_copy_launder(other.m_begin, other.m_end, tmp, m_alloc);
         } catch (...) {
-          AllocTraitsT::deallocate(m_alloc, tmp, other.size());
+          free_buffer(tmp, tmp_cap, 0);
           throw;
         }
-        AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+        deallocate();
         m_begin = tmp;
-        m_end = m_realend = tmp + other.size();
+        m_end = tmp + other.size();
+        m_realend = tmp + tmp_cap;
         return *this;
       }
 
-      // destroy excess
-      while (other.size() < size()) {
-        pop_back();
-      }
-
-      // copy-assign onto existing elements
-      auto tmp = other.m_begin;
-      for (auto& elem : *this) {
-        elem = *std::launder(tmp);
-        ++tmp;
-      }
-
-      // copy-construct new elements
-      while (tmp != other.m_end) {
-        push_back(*std::launder(tmp));
-        ++tmp;
-      }
+      assign_in_place(m_begin, m_end, other.begin(), other.size(), m_alloc);
     }
     return *this;
   }
@@ -242,34 +274,20 @@ public:
         // We must move-assign elements :(
         if (other.size() > capacity()) {
           // We must realloc, so directly move into new buffer
-          auto tmp = allocate_tmp(other.size(), m_alloc);
+          auto [tmp, tmp_cap] = allocate_tmp(other.size(), m_alloc);
           try {
-            uninitialized_move(other.m_begin, other.m_end, tmp, m_alloc);
-            deallocate();
-            m_begin = tmp;
-            m_realend = m_end = tmp + other.size();
+            uninitialized_move_launder(other.m_begin, other.m_end, tmp, m_alloc);
           } catch (...) {
-            AllocTraitsT::deallocate(m_alloc, tmp, other.size());
+            free_buffer(tmp, tmp_cap, 0);
             throw;
           }
+          deallocate();
+          m_begin = tmp;
+          m_end = tmp + other.size();
+          m_realend = tmp + tmp_cap;
         } else {
-          // destroy excess
-          while (other.size() < size()) {
-            pop_back();
-          }
-
-          // move-assign onto existing elements
-          auto tmp = other.m_begin;
-          for (auto& elem : *this) {
-            elem = std::move(*std::launder(tmp));
-            ++tmp;
-          }
-
-          // move-construct new elements
-          while (tmp != other.m_end) {
-            push_back(std::move(*std::launder(tmp)));
-            ++tmp;
-          }
+          assign_in_place(
+            m_begin, m_end, std::make_move_iterator(other.begin()), other.size(), m_alloc);
         }
       } else {
         deallocate();
@@ -288,35 +306,21 @@ public:
   {
     if (il.size() > capacity()) {
       // We must realloc, so directly move into new buffer
-      auto tmp = allocate_tmp(il.size(), m_alloc);
+      auto [tmp, tmp_cap] = allocate_tmp(il.size(), m_alloc);
       try {
-        uninitialized_move(il.begin(), il.end(), tmp, m_alloc);
-        deallocate();
-        m_begin = tmp;
-        m_realend = m_end = tmp + il.size();
+        uninitialized_copy(il.begin(), il.end(), tmp, m_alloc);
       } catch (...) {
-        AllocTraitsT::deallocate(m_alloc, tmp, il.size());
+        free_buffer(tmp, tmp_cap, 0);
         throw;
       }
+      deallocate();
+      m_begin = tmp;
+      m_end = tmp + il.size();
+      m_realend = tmp + tmp_cap;
     } else {
-      // destroy excess
-      while (il.size() < size()) {
-        pop_back();
-      }
-
-      // copy-assign onto existing elements
-      auto tmp = il.begin();
-      for (auto& elem : *this) {
-        elem = *tmp;
-        ++tmp;
-      }
-
-      // copy-construct new elements
-      while (tmp != il.end()) {
-        push_back(*tmp);
-        ++tmp;
-      }
+      assign_in_place(m_begin, m_end, il.begin(), il.size(), m_alloc);
     }
+    return *this;
   }
 
   constexpr //
@@ -382,14 +386,14 @@ public:
     operator[](size_type pos) //
     noexcept
   {
-    return *std::launder(m_begin + pos);
+    return *maybe_launder(m_begin + pos);
   }
   [[nodiscard]] constexpr //
     const_reference
     operator[](size_type pos) //
     const noexcept
   {
-    return *std::launder(m_begin + pos);
+    return *maybe_launder(m_begin + pos);
   }
 
   /////////////
@@ -412,12 +416,36 @@ public:
   [[nodiscard]] constexpr const_iterator cbegin() /**/ const noexcept { return m_begin; }
   [[nodiscard]] constexpr const_iterator cend() /****/ const noexcept { return m_end; }
 
-  [[nodiscard]] constexpr /***/ reverse_iterator rbegin() /*********/ noexcept { return m_end; }
-  [[nodiscard]] constexpr reverse_const_iterator rbegin() /***/ const noexcept { return m_end; }
-  [[nodiscard]] constexpr /***/ reverse_iterator rend() /***********/ noexcept { return m_begin; }
-  [[nodiscard]] constexpr reverse_const_iterator rend() /*****/ const noexcept { return m_begin; }
-  [[nodiscard]] constexpr reverse_const_iterator crbegin() /**/ const noexcept { return m_end; }
-  [[nodiscard]] constexpr reverse_const_iterator crend() /****/ const noexcept { return m_begin; }
+  [[nodiscard]] constexpr //
+    reverse_iterator
+    rbegin() //
+    noexcept
+  {
+    return reverse_iterator(end());
+  }
+  [[nodiscard]] constexpr //
+    reverse_const_iterator
+    rbegin() //
+    const noexcept
+  {
+    return reverse_const_iterator(end());
+  }
+  [[nodiscard]] constexpr //
+    reverse_iterator
+    rend() //
+    noexcept
+  {
+    return reverse_iterator(begin());
+  }
+  [[nodiscard]] constexpr //
+    reverse_const_iterator
+    rend() //
+    const noexcept
+  {
+    return reverse_const_iterator(begin());
+  }
+  [[nodiscard]] constexpr reverse_const_iterator crbegin() /**/ const noexcept { return rbegin(); }
+  [[nodiscard]] constexpr reverse_const_iterator crend() /****/ const noexcept { return rend(); }
 
   [[nodiscard]] constexpr size_type size() /******/ const noexcept { return m_end - m_begin; }
   [[nodiscard]] constexpr size_type capacity() /**/ const noexcept { return m_realend - m_begin; }
@@ -441,17 +469,7 @@ public:
     reserve(size_type new_cap)
   {
     if (new_cap > capacity()) {
-      auto tmp = allocate_tmp(new_cap, m_alloc);
-      try {
-        auto end = uninitialized_move_if_noexcept_launder(m_begin, m_end, tmp, m_alloc);
-        deallocate();
-        m_begin = tmp;
-        m_end = end;
-        m_realend = tmp + new_cap;
-      } catch (...) {
-        AllocTraitsT::deallocate(tmp);
-        throw;
-      }
+      reallocate(new_cap, size(), 0, [](pointer) {});
     }
   }
 
@@ -459,19 +477,11 @@ public:
     void
     shrink_to_fit()
   {
-    auto oldsize = size();
-    if (oldsize < capacity()) {
-      auto tmp = allocate_tmp(oldsize, m_alloc);
-      try {
-        auto end = uninitialized_move_launder(m_begin, m_end, tmp, m_alloc);
-        deallocate();
-        m_begin = tmp;
-        m_end = end;
-        m_realend = tmp + oldsize;
-      } catch (...) {
-        AllocTraitsT::deallocate(tmp);
-        throw;
-      }
+    if (empty()) {
+      deallocate();
+      m_begin = m_end = m_realend = nullptr;
+    } else if (size() < capacity()) {
+      reallocate(size(), size(), 0, [](pointer) {});
     }
   }
 
@@ -480,28 +490,14 @@ public:
     resize(size_type count)
   {
     if (count > capacity()) {
-      auto tmp = allocate_tmp(count, m_alloc);
-      try {
-        auto end = uninitialized_move_if_noexcept_launder(m_begin, m_end, tmp, m_alloc);
-        for (; end < tmp + count; ++end) {
-          AllocTraitsT::construct(m_alloc, end);
-        }
-        deallocate();
-        m_begin = tmp;
-        m_end = end;
-        m_realend = tmp + count;
-      } catch (...) {
-        AllocTraitsT::deallocate(tmp);
-        throw;
-      }
+      auto extra = count - size();
+      reallocate(count, size(), extra, [&](pointer gap) {
+        uninitialized_construct(gap, gap + extra, m_alloc);
+      });
     } else if (count > size()) {
-      while (size() > count) {
-        emplace_back();
-      }
+      m_end = uninitialized_construct(m_end, m_begin + count, m_alloc);
     } else {
-      while (size() > count) {
-        pop_back();
-      }
+      truncate(m_begin + count);
     }
   }
 
@@ -510,30 +506,56 @@ public:
     resize(size_type count, const value_type& value)
   {
     if (count > capacity()) {
-      auto tmp = allocate_tmp(count, m_alloc);
-      try {
-        // We construct new elements first in case value is part of vector_base
-        auto end = tmp + size();
-        for (; end < tmp + count; ++end) {
-          AllocTraitsT::construct(m_alloc, end, value);
-        }
-        end = uninitialized_move_if_noexcept_launder(m_begin, m_end, tmp, m_alloc);
-        deallocate();
-        m_begin = tmp;
-        m_end = end;
-        m_realend = tmp + count;
-      } catch (...) {
-        AllocTraitsT::deallocate(tmp);
-        throw;
-      }
+      auto extra = count - size();
+      reallocate(count, size(), extra, [&](pointer gap) {
+        uninitialized_construct(gap, gap + extra, m_alloc, value);
+      });
     } else if (count > size()) {
-      while (size() > count) {
+      while (size() < count) {
         emplace_back(value);
       }
     } else {
-      while (size() > count) {
-        pop_back();
-      }
+      truncate(m_begin + count);
+    }
+  }
+
+  // Like resize, but default-initializes the new elements,
+  // which leaves them uninitialized for trivial types (outside constant evaluation)
+  constexpr //
+    void
+    resize_for_overwrite(size_type count)
+  {
+    if (count > capacity()) {
+      auto extra = count - size();
+      reallocate(count, size(), extra, [&](pointer gap) {
+        uninitialized_default_construct(gap, gap + extra, m_alloc);
+      });
+    } else if (count > size()) {
+      m_end = uninitialized_default_construct(m_end, m_begin + count, m_alloc);
+    } else {
+      truncate(m_begin + count);
+    }
+  }
+
+  // Like C++23's std::string::resize_and_overwrite.
+  // Resizes to count elements as if by resize_for_overwrite, then calls op(data(), count),
+  // which must return the number of elements to keep (at most count).
+  // If op throws, the vector is truncated back to its original size.
+  template<typename Operation>
+  constexpr //
+    void
+    resize_and_overwrite(size_type count, Operation op)
+  {
+    auto oldsize = size();
+    if (count > oldsize) {
+      resize_for_overwrite(count);
+    }
+    try {
+      auto new_size = static_cast<size_type>(std::move(op)(m_begin, count));
+      truncate(m_begin + new_size);
+    } catch (...) {
+      truncate(m_begin + std::min(oldsize, size()));
+      throw;
     }
   }
 
@@ -542,9 +564,7 @@ public:
     clear() //
     noexcept
   {
-    while (not empty()) {
-      pop_back();
-    }
+    truncate(m_begin);
   }
 
   /////////////////////////
@@ -558,29 +578,14 @@ public:
     emplace_back(Args&&... args)
   {
     if (m_end < m_realend) {
-      AllocTraitsT::construct(m_alloc, std::launder(m_end), std::forward<Args>(args)...);
+      AllocTraitsT::construct(m_alloc, maybe_launder(m_end), std::forward<Args>(args)...);
       ++m_end;
+      return;
     }
 
-    // Ensure we've fully prepared a tmp buffer before deallocating m_begin
-    auto oldsize = size();
-    auto newcap = size() * 2 + 1;
-    auto tmp = allocate_tmp(newcap, m_alloc);
-    try {
-      // construct new value into tmp, we should do this first in case input is part of the
-      // vector_base
-      AllocTraitsT::construct(m_alloc, tmp + oldsize, std::forward<Args>(args)...);
-      // move existing values if noexcept, else copy
-      uninitialized_move_if_noexcept_launder(m_begin, m_end, tmp, m_alloc);
-    } catch (...) {
-      AllocTraitsT::deallocate(m_alloc, tmp, newcap);
-      throw;
-    }
-    // buffer is ready, do the swap
-    AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
-    m_begin = tmp;
-    m_end = tmp + oldsize + 1;
-    m_realend = tmp + newcap;
+    reallocate(grow_capacity(size() + 1), size(), 1, [&](pointer gap) {
+      AllocTraitsT::construct(m_alloc, gap, std::forward<Args>(args)...);
+    });
   }
 
   // Strong exception guarantee
@@ -592,36 +597,20 @@ public:
   // as long as value_type is nothrow assignable and constructible either by move or copy.
   template<typename... Args>
   constexpr //
-    pointer
-    emplace(const_pointer pos, Args&&... args)
+    iterator
+    emplace(const_iterator pos, Args&&... args)
   {
     if (pos == m_end) {
-      emplace_back(args...);
+      emplace_back(std::forward<Args>(args)...);
       return m_end - 1;
     }
 
     if (m_end == m_realend) {
       // We need to realloc
       auto index = pos - m_begin;
-      auto oldsize = size();
-      auto newcap = size() * 2 + 1;
-      auto tmp = allocate_tmp(newcap, m_alloc);
-      try {
-        // construct new value into tmp, we should do this first in case input is part of the
-        // vector_base
-        AllocTraitsT::construct(m_alloc, tmp + index, std::forward<T>(args)...);
-        // move existing values if noexcept, else copy
-        uninitialized_move_if_noexcept_launder(m_begin, pos, tmp, m_alloc);
-        uninitialized_move_if_noexcept_launder(pos, m_end, tmp + index + 1, m_alloc);
-      } catch (...) {
-        AllocTraitsT::deallocate(m_alloc, tmp, newcap);
-        throw;
-      }
-      // buffer is ready, do the swap
-      AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
-      m_begin = tmp;
-      m_end = tmp + oldsize + 1;
-      m_realend = tmp + newcap;
+      reallocate(grow_capacity(size() + 1), index, 1, [&](pointer gap) {
+        AllocTraitsT::construct(m_alloc, gap, std::forward<Args>(args)...);
+      });
       return m_begin + index;
     }
 
@@ -630,22 +619,18 @@ public:
     // ... unfortunately we can't shift the elements first, THEN construct
     // because if the constructor throws we aren't supposed to UB
     // So we start by constructing the element into a temporary that we move into place later.
-    auto tmp = T(std::forward<T>(args)...);
+    auto tmp = T(std::forward<Args>(args)...);
     // After this point, everything is either allowed to UB or is noexcept :)
-
-    // Shift elements back
-    uninitialized_move_if_noexcept_launder_backward(m_end - 1, m_end, m_end + 1, m_alloc);
-    move_if_noexcept_launder_backward(pos, m_end - 1, m_end);
-    // Now move the tmp var into place
-    *pos = std::move_if_noexcept(tmp);
-    return pos;
+    auto p = m_begin + (pos - m_begin);
+    insert_one_in_place(p, m_end, std::move_if_noexcept(tmp), m_alloc);
+    return p;
   }
 
   constexpr //
     iterator
     insert(const_iterator pos, const T& value)
   {
-    insert(pos, 1, value);
+    return insert(pos, 1, value);
   }
 
   constexpr //
@@ -653,89 +638,48 @@ public:
     insert(const_iterator pos, T&& value)
   {
     if (pos == m_end) {
-      emplace_back(value);
+      emplace_back(std::move(value));
       return m_end - 1;
     }
 
-    if (m_end + 1 < m_realend) {
+    if (m_end == m_realend) {
       // We need to realloc
       auto index = pos - m_begin;
-      auto oldsize = size();
-      auto newcap = size() * 2 + 1;
-      auto tmp = allocate_tmp(newcap, m_alloc);
-      try {
-        // construct new values into tmp, we should do this first in case input is part of the
-        // vector_base
-        AllocTraitsT::construct(m_alloc, tmp + index, std::move(value));
-        // move existing values if noexcept, else copy
-        uninitialized_move_if_noexcept_launder(m_begin, pos, tmp, m_alloc);
-        uninitialized_move_if_noexcept_launder(pos, m_end, tmp + index + 1, m_alloc);
-      } catch (...) {
-        AllocTraitsT::deallocate(m_alloc, tmp, newcap);
-        throw;
-      }
-      // buffer is ready, do the swap
-      AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
-      m_begin = tmp;
-      m_end = tmp + oldsize + 1;
-      m_realend = tmp + newcap;
+      reallocate(grow_capacity(size() + 1), index, 1, [&](pointer gap) {
+        AllocTraitsT::construct(m_alloc, gap, std::move(value));
+      });
       return m_begin + index;
     }
 
     // No realloc needed
-    // Shift elements back
-    uninitialized_move_if_noexcept_launder_backward(m_end - 1, m_end, m_end + 1, m_alloc);
-    move_if_noexcept_launder_backward(pos, m_end - 1, m_end);
-    // Now move value into place
-    pos = std::move(value);
-    return pos;
+    auto p = m_begin + (pos - m_begin);
+    insert_one_in_place(p, m_end, std::move(value), m_alloc);
+    return p;
   }
 
   constexpr //
     iterator
     insert(const_iterator pos, size_type count, const T& value)
   {
-    if (count != 0) {
-      if (pos == m_end) {
-        emplace_back(value);
-        return m_end - 1;
-      }
-
-      if (m_end + count < m_realend) {
-        // We need to realloc
-        auto index = pos - m_begin;
-        auto oldsize = size();
-        auto newcap = size() * 2 + count;
-        auto tmp = allocate_tmp(newcap, m_alloc);
-        try {
-          // construct new values into tmp, we should do this first in case input is part of the
-          // vector_base
-          for (auto it = tmp + index; it < tmp + index + count; ++it) {
-            AllocTraitsT::construct(m_alloc, it, value);
-          }
-          // move existing values if noexcept, else copy
-          uninitialized_move_if_noexcept_launder(m_begin, pos, tmp, m_alloc);
-          uninitialized_move_if_noexcept_launder(pos, m_end, tmp + index + count, m_alloc);
-        } catch (...) {
-          AllocTraitsT::deallocate(m_alloc, tmp, newcap);
-          throw;
-        }
-        // buffer is ready, do the swap
-        AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
-        m_begin = tmp;
-        m_end = tmp + oldsize + count;
-        m_realend = tmp + newcap;
-        return m_begin + index;
-      }
+    auto index = pos - m_begin;
+    if (count == 0) {
+      return m_begin + index;
+    }
 
-      // No realloc needed
-      // Shift elements back
-      uninitialized_move_if_noexcept_launder_backward(m_end - count, m_end, m_end + count, m_alloc);
-      move_if_noexcept_launder_backward(pos, m_end - count, m_end);
-      // Now copy the value into place repeatedly
-      std::fill(pos, pos + count, value);
-      return pos;
+    if (count > static_cast<size_type>(m_realend - m_end)) {
+      // We need to realloc
+      reallocate(grow_capacity(size() + count), index, count, [&](pointer gap) {
+        uninitialized_construct(gap, gap + count, m_alloc, value);
+      });
+      return m_begin + index;
     }
+
+    // No realloc needed
+    // Copy value first in case it is part of the vector_base
+    auto tmp = T(value);
+    auto p = m_begin + index;
+    insert_fill_in_place(p, m_end, count, tmp, m_alloc);
+    return p;
   }
 
   // Not quite the same as LegacyInputIterator,
@@ -745,17 +689,7 @@ public:
     iterator
     insert(const_iterator pos, InputIt first, InputIt last)
   {
-    // Since input iterator is single pass, we will just insert one at a time the dumb way.
-    // TODO: copy first to a vector then call the random_access_iterator overload.
-
-    // Convert iterator to an index first to handle reallocation case
-    auto index = std::distance(m_begin, pos);
-    while (first != last) {
-      insert(m_begin + index, *first);
-      ++index;
-      ++first;
-    }
-    return m_begin + index;
+    return insert_range(pos, std::ranges::subrange(first, last));
   }
 
   constexpr //
@@ -765,6 +699,48 @@ public:
     return insert(pos, ilist.begin(), ilist.end());
   }
 
+  // Like C++23's std::vector::insert_range.
+  // Forward and sized ranges reallocate at most once, and shift the tail only once.
+  // Input ranges are buffered first, unless they are inserted at the end anyway.
+  template<std::ranges::input_range R>
+  constexpr //
+    iterator
+    insert_range(const_iterator pos, R&& rg)
+  {
+    auto index = static_cast<size_type>(pos - m_begin);
+    if constexpr (std::ranges::forward_range<R>) {
+      insert_forward(index, std::ranges::begin(rg), std::ranges::distance(rg));
+    } else if (index == size()) {
+      append_range(std::forward<R>(rg));
+    } else {
+      auto tmp = vector_base(m_alloc);
+      tmp.append_range(std::forward<R>(rg));
+      insert_forward(index, std::make_move_iterator(tmp.m_begin), tmp.size());
+    }
+    return m_begin + index;
+  }
+
+  // Like C++23's std::vector::append_range
+  template<std::ranges::input_range R>
+  constexpr //
+    void
+    append_range(R&& rg)
+  {
+    if constexpr (std::ranges::forward_range<R>) {
+      insert_forward(size(), std::ranges::begin(rg), std::ranges::distance(rg));
+    } else {
+      if constexpr (std::ranges::sized_range<R>) {
+        auto count = static_cast<size_type>(std::ranges::size(rg));
+        if (count > static_cast<size_type>(m_realend - m_end)) {
+          reallocate(grow_capacity(size() + count), size(), 0, [](pointer) {});
+        }
+      }
+      for (auto it = std::ranges::begin(rg); it != std::ranges::end(rg); ++it) {
+        emplace_back(*it);
+      }
+    }
+  }
+
   ///////////////////////
   // Removal modifiers //
   ///////////////////////
@@ -773,8 +749,7 @@ public:
     void
     pop_back() //
   {
-    AllocTraitsT::destroy(m_alloc, std::launder(m_end - 1));
-    --m_end;
+    truncate(m_end - 1);
   }
 
   constexpr //
@@ -788,11 +763,48 @@ public:
     iterator
     erase(const_iterator first, const_iterator last)
   {
-    move_if_noexcept_launder(last, m_end, first, m_alloc);
-    for (size_t i = 0; i < last - first; ++i) {
-      pop_back();
+    auto p = m_begin + (first - m_begin);
+    erase_in_place(p, m_begin + (last - m_begin), m_end, m_alloc);
+    return p;
+  }
+
+  // Erases every element for which pred returns true, keeping the order of the rest.
+  // pred is called exactly once per element, front to back.
+  // Outside constant evaluation, memcpy relocatable elements are relocated instead of being
+  // move-assigned one at a time, see erase_if_in_place.
+  // If pred throws, the elements it has already returned true for are erased.
+  template<typename Pred>
+  constexpr //
+    size_type
+    erase_if(Pred pred)
+  {
+    return erase_if_in_place(m_begin, m_end, pred, m_alloc);
+  }
+
+  // Like erase(pos), but moves the last element into pos instead of shifting everything after it.
+  // Returns an iterator to the element which took pos's place (or end() if pos was the last).
+  constexpr //
+    iterator
+    unordered_erase(const_iterator pos)
+  {
+    auto p = m_begin + (pos - m_begin);
+    if (p != m_end - 1) {
+      *maybe_launder(p) = std::move(*maybe_launder(m_end - 1));
     }
-    return first;
+    pop_back();
+    return p;
+  }
+
+  // Like erase_if, but fills the gaps with elements from the back instead of shifting everything
+  // down, so the order of the remaining elements isn't kept. Moves at most one element per erased
+  // element. pred is called exactly once per element.
+  // If pred throws, the elements it has already returned true for are erased.
+  template<typename Pred>
+  constexpr //
+    size_type
+    unordered_erase_if(Pred pred)
+  {
+    return unordered_erase_if_in_place(m_begin, m_end, pred, m_alloc);
   }
 
   //////////////////////////
@@ -805,7 +817,7 @@ public:
     const noexcept(noexcept(*begin() == *other.begin())) //
     requires std::equality_comparable<T>
   {
-    return std::equal(begin(), end(), other.begin(), other.end());
+    return constexpr_containers::equal(begin(), end(), other.begin(), other.end());
   }
 
   [[nodiscard]] constexpr //
@@ -818,16 +830,8 @@ public:
     elem < elem;
   } //
   {
-    if constexpr (std::three_way_comparable<T>) {
-      return std::lexicographical_compare_three_way(m_begin, m_end, other.m_begin, other.m_end);
-    } else {
-      return std::lexicographical_compare_three_way(
-        m_begin, m_end, other.m_begin, other.m_end, [](const auto& a, const auto& b) {
-          return a < b ? std::weak_ordering::less :
-                 b < a ? std::weak_ordering::greater :
-                         std::weak_ordering::equivalent;
-        });
-    }
+    return constexpr_containers::lexicographical_compare_three_way(
+      begin(), end(), other.begin(), other.end());
   }
 
   /////////////////////////////////////////
@@ -840,8 +844,10 @@ private:
     allocate(size_type capacity, Allocator& alloc)
   {
     try {
-      m_begin = AllocTraitsT::allocate(alloc, capacity);
-      m_realend = m_begin + capacity;
+      auto [ptr, count] = allocate_at_least(alloc, capacity);
+      StatsPolicy::on_allocate(count, sizeof(T));
+      m_begin = ptr;
+      m_realend = ptr + count;
     } catch (...) {
       if (capacity > max_size()) {
         throw std::length_error("Tried to allocate too many elements.");
@@ -851,12 +857,16 @@ private:
     }
   }
 
+  // Allocates a buffer without touching the current one.
+  // The returned count may exceed capacity, if the allocator has room to spare.
   constexpr //
-    pointer
+    allocation_result<pointer, size_type>
     allocate_tmp(size_type capacity, Allocator& alloc)
   {
     try {
-      return AllocTraitsT::allocate(alloc, capacity, m_begin);
+      auto result = allocate_at_least(alloc, capacity);
+      StatsPolicy::on_allocate(result.count, sizeof(T));
+      return result;
     } catch (...) {
       if (capacity > max_size()) {
         throw std::length_error("Tried to allocate too many elements.");
@@ -866,37 +876,163 @@ private:
     }
   }
 
+  // The capacity to grow to when we need room for required elements, according to GrowthPolicy
+  [[nodiscard]] constexpr //
+    size_type
+    grow_capacity(size_type required) //
+    const
+  {
+    if (required > max_size()) {
+      throw std::length_error("Tried to allocate too many elements.");
+    }
+    size_type cap = GrowthPolicy::next_capacity(capacity(), required, sizeof(T));
+    return std::max(required, std::min(cap, max_size()));
+  }
+
+  // Moves every element into a new buffer of at least new_cap elements, leaving gap uninitialized
+  // slots at index. fill(first_slot) must construct all gap elements (or throw having constructed
+  // none), and runs before any element is relocated, in case its arguments are part of the
+  // vector_base.
+  // When growing at the end, the allocator first gets a chance to expand the buffer in place,
+  // in which case nothing is relocated at all.
+  // Strong exception guarantee, as long as relocating doesn't have to fall back on a throwing move.
+  template<typename Fill>
+  constexpr //
+    void
+    reallocate(size_type new_cap, size_type index, size_type gap, Fill fill)
+  {
+    auto oldsize = size();
+    if (m_begin and index == oldsize) {
+      if (auto count = try_expand(m_alloc, m_begin, capacity(), new_cap)) {
+        StatsPolicy::on_expand(capacity(), count, sizeof(T));
+        m_realend = m_begin + count;
+        fill(m_end);
+        m_end += gap;
+        return;
+      }
+    }
+    auto [tmp, tmp_cap] = allocate_tmp(new_cap, m_alloc);
+    try {
+      fill(tmp + index);
+    } catch (...) {
+      free_buffer(tmp, tmp_cap, 0);
+      throw;
+    }
+    try {
+      relocate_into(tmp, index, gap);
+    } catch (...) {
+      destroy_launder(tmp + index, tmp + index + gap, m_alloc);
+      free_buffer(tmp, tmp_cap, 0);
+      throw;
+    }
+    // buffer is ready, do the swap, the old buffer no longer holds any objects
+    if (m_begin) {
+      StatsPolicy::on_relocate(oldsize, sizeof(T));
+      free_buffer(m_begin, capacity(), oldsize);
+    }
+    m_begin = tmp;
+    m_end = tmp + oldsize + gap;
+    m_realend = tmp + tmp_cap;
+  }
+
+  // Relocates every element into tmp, skipping gap slots at index.
+  // Trivially relocatable types are memcpy'd over at runtime, with no per-element destroy.
+  // Otherwise, the old elements are only destroyed once every element has been moved (or copied).
+  constexpr //
+    void
+    relocate_into(pointer tmp, size_type index, size_type gap)
+  {
+    auto pos = m_begin + index;
+    if constexpr (is_memcpy_relocatable_v<T, Allocator>) {
+      if (not std::is_constant_evaluated()) {
+        uninitialized_relocate_launder(m_begin, pos, tmp, m_alloc);
+        uninitialized_relocate_launder(pos, m_end, tmp + index + gap, m_alloc);
+        return;
+      }
+    }
+    auto mid = uninitialized_move_if_noexcept_launder(m_begin, pos, tmp, m_alloc);
+    try {
+      uninitialized_move_if_noexcept_launder(pos, m_end, mid + gap, m_alloc);
+    } catch (...) {
+      destroy_launder(tmp, mid, m_alloc);
+      throw;
+    }
+    destroy_launder(m_begin, m_end, m_alloc);
+  }
+
+  // Inserts the count elements starting at first at index, reallocating at most once.
+  // first must not point into this vector_base (unless it reallocates).
+  template<std::input_iterator It>
+  constexpr //
+    void
+    insert_forward(size_type index, It first, std::iter_difference_t<It> n)
+  {
+    auto count = static_cast<size_type>(n);
+    if (count == 0) {
+      return;
+    }
+    auto last = std::ranges::next(first, n);
+
+    if (count > static_cast<size_type>(m_realend - m_end)) {
+      // We need to realloc
+      reallocate(grow_capacity(size() + count), index, count, [&](pointer gap) {
+        uninitialized_copy(first, last, gap, m_alloc);
+      });
+      return;
+    }
+
+    // No realloc needed
+    insert_copy_in_place(m_begin + index, m_end, first, count, m_alloc);
+  }
+
+  // Destroys every element from new_end onwards in one go,
+  // which is free for trivially destructible types.
+  constexpr //
+    void
+    truncate(pointer new_end) //
+    noexcept
+  {
+    destroy_launder(new_end, m_end, m_alloc);
+    m_end = new_end;
+  }
+
   constexpr //
     void
     deallocate() //
     noexcept
   {
+    auto used = size();
     clear();
-    if (m_begin)
-      AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+    if (m_begin) {
+      free_buffer(m_begin, capacity(), used);
+    }
+  }
+
+  // Every buffer is freed through here, so that StatsPolicy sees it
+  constexpr //
+    void
+    free_buffer(pointer p, size_type count, size_type used) //
+    noexcept
+  {
+    StatsPolicy::on_deallocate(count, used, sizeof(T));
+    AllocTraitsT::deallocate(m_alloc, p, count);
   }
 };
 
-template<typename T, typename Alloc, typename U>
+template<typename T, typename Alloc, typename Growth, typename Stats, typename U>
 constexpr //
-  typename vector_base<T, Alloc>::size_type
-  erase(vector_base<T, Alloc>& c, const U& value)
+  typename vector_base<T, Alloc, Growth, Stats>::size_type
+  erase(vector_base<T, Alloc, Growth, Stats>& c, const U& value)
 {
-  auto it = std::remove(c.begin(), c.end(), value);
-  auto r = std::distance(it, c.end());
-  c.erase(it, c.end());
-  return r;
+  return detail::erase_value<T>(c, value);
 }
 
-template<typename T, typename Alloc, typename Pred>
+template<typename T, typename Alloc, typename Growth, typename Stats, typename Pred>
 constexpr //
-  typename vector_base<T, Alloc>::size_type
-  erase_if(vector_base<T, Alloc>& c, Pred pred)
+  typename vector_base<T, Alloc, Growth, Stats>::size_type
+  erase_if(vector_base<T, Alloc, Growth, Stats>& c, Pred pred)
 {
-  auto it = std::remove_if(c.begin(), c.end(), pred);
-  auto r = std::distance(it, c.end());
-  c.erase(it, c.end());
-  return r;
+  return c.erase_if(std::move(pred));
 }
 
 } // namespace constexpr_containers
@@ -1,3 +1,270 @@
-// This file is only used to give iwyu a chance to fix header files
+// Checks zip_transform's paths (contiguous and disjoint, in place, overlapping, through a
+// back_insert_iterator) against a plain loop, during constant evaluation too, and that comparing
+// enums with their own operators doesn't take the memcmp path.
+
+#include <compare>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <vector>
+
 #include "constexpr_containers/algorithm.h"
-int main() {}
+#include "constexpr_containers/simd_transform.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+// Covers the simd width, the fixed size blocks and the scalar tails
+constexpr std::size_t sizes[] = { 0, 1, 3, 7, 8, 9, 31, 64, 100, 1001 };
+
+constexpr cec::vector<int>
+iota(std::size_t n, int start)
+{
+  auto v = cec::vector<int>(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v[i] = start + int(i);
+  }
+  return v;
+}
+
+constexpr auto axpy = [](auto a, auto b) { return a * 2 + b; };
+
+template<typename Op>
+constexpr bool
+disjoint(Op op)
+{
+  for (auto n : sizes) {
+    auto a = iota(n, 1);
+    auto b = iota(n, -3);
+    auto out = cec::vector<int>(n);
+    auto end = cec::zip_transform(a.begin(), a.end(), out.begin(), op, b.begin());
+    if (end != out.end()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      if (out[i] != a[i] * 2 + b[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+constexpr bool
+disjoint_plain()
+{
+  return disjoint(axpy);
+}
+
+bool
+disjoint_vectorizable()
+{
+  return disjoint(cec::simd::vectorizable{ axpy });
+}
+
+// dst is one of the inputs
+template<typename Op>
+constexpr bool
+in_place(Op op)
+{
+  for (auto n : sizes) {
+    auto a = iota(n, 1);
+    auto b = iota(n, 5);
+    cec::zip_transform(a.begin(), a.end(), a.begin(), op, b.begin());
+    for (std::size_t i = 0; i < n; ++i) {
+      if (a[i] != (int(i) + 1) * 2 + b[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// dst is an input shifted by one, so every result is read back as the next input
+template<typename Op>
+constexpr bool
+overlapping(Op op)
+{
+  for (auto n : sizes) {
+    auto a = iota(n + 1, 1);
+    cec::zip_transform(a.begin(), a.end() - 1, a.begin() + 1, op);
+    for (std::size_t i = 0; i <= n; ++i) {
+      if (a[i] != 1 + 2 * int(i)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+constexpr auto add2 = [](auto x) { return x + 2; };
+
+constexpr bool
+in_place_plain()
+{
+  return in_place(axpy);
+}
+
+bool
+in_place_vectorizable()
+{
+  return in_place(cec::simd::vectorizable{ axpy });
+}
+
+constexpr bool
+overlapping_plain()
+{
+  return overlapping(add2);
+}
+
+// Can't be done a simd at a time, so it isn't
+bool
+overlapping_vectorizable()
+{
+  return overlapping(cec::simd::vectorizable{ add2 });
+}
+
+// op reads dst through a reference of its own, which the contiguous path mustn't assume away
+constexpr bool
+op_reads_dst()
+{
+  for (auto n : sizes) {
+    auto a = cec::vector<int>(n, 1);
+    auto out = cec::vector<int>(n, 0);
+    cec::zip_transform(a.begin(), a.end(), out.begin(), [&](int x) { return x + out[0]; });
+    for (std::size_t i = 1; i < n; ++i) {
+      if (out[i] != 2) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template<typename Container>
+constexpr bool
+back_inserter()
+{
+  for (auto n : sizes) {
+    auto a = iota(n, 1);
+    auto b = iota(n, -3);
+    auto out = Container{ 7 };
+    cec::zip_transform(a.begin(), a.end(), std::back_inserter(out), axpy, b.begin());
+    auto expected = Container{ 7 };
+    for (std::size_t i = 0; i < n; ++i) {
+      expected.push_back(a[i] * 2 + b[i]);
+    }
+    if (out != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// append_range, reserve, and neither
+constexpr bool
+back_inserter_vector()
+{
+  return back_inserter<cec::vector<int>>();
+}
+
+constexpr bool
+back_inserter_std_vector()
+{
+  return back_inserter<std::vector<int>>();
+}
+
+bool
+back_inserter_list()
+{
+  return back_inserter<std::list<int>>();
+}
+
+enum class plain_color : unsigned char
+{
+  red,
+  green,
+  blue,
+};
+
+// Equal whatever the value, and ordered backwards, so comparing bytes gets it wrong
+enum class custom_color : unsigned char
+{
+  red,
+  green,
+  blue,
+};
+
+constexpr bool
+operator==(custom_color /*a*/, custom_color /*b*/)
+{
+  return true;
+}
+
+constexpr std::strong_ordering
+operator<=>(custom_color a, custom_color b)
+{
+  return int(b) <=> int(a);
+}
+
+static_assert(
+  cec::detail::is_bytewise_comparable_v<const plain_color*, const plain_color*> and
+  not cec::detail::is_bytewise_comparable_v<const custom_color*, const custom_color*>);
+
+// The user declared operators are called, at runtime as during constant evaluation
+constexpr bool
+enum_comparisons()
+{
+  auto a = cec::vector<custom_color>{ custom_color::red, custom_color::green };
+  auto b = cec::vector<custom_color>{ custom_color::blue, custom_color::red };
+  auto c = cec::vector<plain_color>{ plain_color::red, plain_color::green };
+  auto d = cec::vector<plain_color>{ plain_color::blue, plain_color::red };
+  return a == b and (a <=> b) == std::strong_ordering::greater and
+         cec::equal(a.begin(), a.end(), b.begin(), b.end()) and c != d and c < d;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "disjoint_plain", disjoint_plain },
+  { "disjoint_vectorizable", disjoint_vectorizable },
+  { "in_place_plain", in_place_plain },
+  { "in_place_vectorizable", in_place_vectorizable },
+  { "overlapping_plain", overlapping_plain },
+  { "overlapping_vectorizable", overlapping_vectorizable },
+  { "op_reads_dst", op_reads_dst },
+  { "back_inserter_vector", back_inserter_vector },
+  { "back_inserter_std_vector", back_inserter_std_vector },
+  { "back_inserter_list", back_inserter_list },
+  { "enum_comparisons", enum_comparisons },
+};
+
+static_assert(disjoint_plain());
+static_assert(in_place_plain());
+static_assert(overlapping_plain());
+static_assert(op_reads_dst());
+static_assert(back_inserter_vector());
+static_assert(back_inserter_std_vector());
+static_assert(enum_comparisons());
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
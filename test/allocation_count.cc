@@ -0,0 +1,340 @@
+// Checks exactly how many allocations, constructions and destructions vector operations cost,
+// both during constant evaluation (static_assert) and at runtime.
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <unistd.h>
+
+#include "constexpr_containers/allocator.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+struct counts
+{
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t constructs = 0;
+  std::size_t destroys = 0;
+
+  constexpr bool operator==(const counts&) const = default;
+};
+
+// Counts into a counts object owned by the test, so it also works during constant evaluation
+template<typename T>
+struct counting_allocator
+{
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  counts* c;
+
+  constexpr explicit counting_allocator(counts* c) noexcept
+    : c(c)
+  {}
+  template<typename U>
+  constexpr counting_allocator(const counting_allocator<U>& other) noexcept
+    : c(other.c)
+  {}
+
+  constexpr T* allocate(std::size_t n)
+  {
+    ++c->allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  constexpr void deallocate(T* p, std::size_t n) noexcept
+  {
+    ++c->deallocations;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template<typename... Args>
+  constexpr void construct(T* p, Args&&... args)
+  {
+    ++c->constructs;
+    std::construct_at(p, std::forward<Args>(args)...);
+  }
+  constexpr void destroy(T* p) noexcept
+  {
+    ++c->destroys;
+    std::destroy_at(p);
+  }
+
+  constexpr bool operator==(const counting_allocator& other) const noexcept
+  {
+    return c == other.c;
+  }
+};
+
+using vector = cec::vector<int, counting_allocator<int>>;
+
+// Carves allocations out of one block, and can grow the last one in place for as long as the
+// block lasts
+template<typename T>
+struct expanding_allocator : counting_allocator<T>
+{
+  T* block;
+  std::size_t* used;
+
+  constexpr expanding_allocator(counts* c, T* block, std::size_t* used) noexcept
+    : counting_allocator<T>(c)
+    , block(block)
+    , used(used)
+  {}
+
+  constexpr T* allocate(std::size_t n)
+  {
+    ++this->c->allocations;
+    *used += n;
+    return block + (*used - n);
+  }
+  constexpr void deallocate(T* /*p*/, std::size_t /*n*/) noexcept { ++this->c->deallocations; }
+
+  constexpr std::size_t try_expand(T* p, std::size_t count, std::size_t n) noexcept
+  {
+    if (p + count != block + *used) {
+      return 0;
+    }
+    *used += n - count;
+    return n;
+  }
+};
+
+// Growing one element at a time doubles the capacity: 1, 2, 4, ..., 1024
+constexpr bool
+push_back()
+{
+  counts c;
+  {
+    auto v = vector(counting_allocator<int>(&c));
+    for (int i = 0; i < 1000; ++i) {
+      v.push_back(i);
+    }
+    // 1000 new elements, plus 1 + 2 + ... + 512 relocated ones
+    if (c != counts{ 11, 10, 2023, 1023 } or v.capacity() != 1024) {
+      return false;
+    }
+  }
+  return c == counts{ 11, 11, 2023, 2023 };
+}
+
+// push_back must be amortized O(1), whatever the size
+constexpr bool
+push_back_is_amortized()
+{
+  for (std::size_t n : { 1, 2, 3, 100, 1000, 4097 }) {
+    counts c;
+    auto v = vector(counting_allocator<int>(&c));
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(int(i));
+    }
+    auto log2 = std::size_t(0);
+    while ((std::size_t(1) << log2) < n) {
+      ++log2;
+    }
+    if (c.allocations != log2 + 1 or c.constructs > 3 * n) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool
+reserve()
+{
+  counts c;
+  auto v = vector(counting_allocator<int>(&c));
+  v.reserve(1000);
+  for (int i = 0; i < 1000; ++i) {
+    v.emplace_back(i);
+  }
+  // Reserving less than the capacity does nothing
+  v.reserve(10);
+  return c == counts{ 1, 0, 1000, 0 };
+}
+
+constexpr bool
+emplace_and_insert()
+{
+  counts c;
+  auto v = vector(counting_allocator<int>(&c));
+  v.reserve(16);
+  v.resize(4);
+  // Shifts the last element into uninitialized memory, everything else is assigned
+  v.emplace(v.begin() + 1, 1);
+  v.insert(v.begin(), 2);
+  if (c != counts{ 1, 0, 6, 0 } or v.size() != 6) {
+    return false;
+  }
+  // Constructs 3 elements past the old end, and shifts 1 element into uninitialized memory
+  v.insert(v.begin() + 5, 3, 7);
+  if (c != counts{ 1, 0, 9, 0 } or v.size() != 9) {
+    return false;
+  }
+  // Needs to grow, doubling to 32: 9 relocated elements and 8 new ones
+  v.insert(v.begin(), 8, 9);
+  return c == counts{ 2, 1, 26, 9 } and v.capacity() == 32;
+}
+
+constexpr bool
+erase()
+{
+  counts c;
+  vector v(10, 1, counting_allocator<int>(&c));
+  v.erase(v.begin(), v.begin() + 3);
+  v.erase(v.begin());
+  v.pop_back();
+  return c == counts{ 1, 0, 10, 5 } and v.size() == 5;
+}
+
+constexpr bool
+resize()
+{
+  counts c;
+  auto v = vector(counting_allocator<int>(&c));
+  v.resize(10);
+  v.resize(5);
+  v.resize(8, 1);
+  if (c != counts{ 1, 0, 13, 5 }) {
+    return false;
+  }
+  // resize grows to exactly what was asked for
+  v.resize(20);
+  return c == counts{ 2, 1, 33, 13 } and v.capacity() == 20;
+}
+
+constexpr bool
+shrink_to_fit()
+{
+  counts c;
+  auto v = vector(counting_allocator<int>(&c));
+  v.reserve(100);
+  v.resize(10);
+  v.shrink_to_fit();
+  if (c != counts{ 2, 1, 20, 10 } or v.capacity() != 10) {
+    return false;
+  }
+  // Already fits
+  v.shrink_to_fit();
+  v.clear();
+  v.shrink_to_fit();
+  return c == counts{ 2, 2, 20, 20 } and v.capacity() == 0;
+}
+
+constexpr bool
+assignment()
+{
+  counts c;
+  vector a(10, 1, counting_allocator<int>(&c));
+  vector b(5, 2, counting_allocator<int>(&c));
+  // Doesn't fit, so b gets a new buffer
+  b = a;
+  if (c != counts{ 3, 1, 25, 5 }) {
+    return false;
+  }
+  // Fits, so elements are assigned and the rest destroyed
+  a.resize(3);
+  b = a;
+  if (c != counts{ 3, 1, 25, 19 }) {
+    return false;
+  }
+  // Steals the buffer
+  b = std::move(a);
+  return c == counts{ 3, 2, 25, 22 };
+}
+
+// Growing at the end expands the buffer in place rather than relocating the elements
+constexpr bool
+expand_in_place()
+{
+  counts c;
+  auto used = std::size_t(0);
+  auto* block = std::allocator<int>().allocate(1024);
+  auto ok = true;
+  {
+    auto v = cec::vector<int, expanding_allocator<int>>(expanding_allocator<int>(&c, block, &used));
+    v.push_back(0);
+    auto* data = v.data();
+    for (int i = 1; i < 100; ++i) {
+      v.push_back(i);
+    }
+    // 1 allocation and 100 new elements, nothing relocated
+    ok = ok and v.data() == data and v.capacity() == 128 and c == counts{ 1, 0, 100, 0 };
+
+    // Once something else is allocated after it, growing has to relocate
+    auto w = cec::vector<int, expanding_allocator<int>>(expanding_allocator<int>(&c, block, &used));
+    w.push_back(0);
+    v.resize(129);
+    ok = ok and v.data() != data and v[99] == 99 and c == counts{ 3, 1, 230, 100 };
+  }
+  std::allocator<int>().deallocate(block, 1024);
+  return ok and c == counts{ 3, 3, 230, 230 };
+}
+
+// Whether mremap finds room after the mapping depends on the address space, so this only checks
+// that growth keeps the elements either way
+bool
+mmap_allocator()
+{
+  auto v = cec::vector<long, cec::mmap_allocator<long>>();
+  v.push_back(0);
+  if (v.capacity() != std::size_t(sysconf(_SC_PAGESIZE)) / sizeof(long)) {
+    return false;
+  }
+  for (long i = 1; i < 100000; ++i) {
+    v.push_back(i);
+  }
+  for (long i = 0; i < 100000; ++i) {
+    if (v[std::size_t(i)] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "push_back", push_back },
+  { "push_back_is_amortized", push_back_is_amortized },
+  { "reserve", reserve },
+  { "emplace_and_insert", emplace_and_insert },
+  { "erase", erase },
+  { "resize", resize },
+  { "shrink_to_fit", shrink_to_fit },
+  { "assignment", assignment },
+  { "expand_in_place", expand_in_place },
+  { "mmap_allocator", mmap_allocator },
+};
+
+static_assert(push_back());
+static_assert(push_back_is_amortized());
+static_assert(reserve());
+static_assert(emplace_and_insert());
+static_assert(erase());
+static_assert(resize());
+static_assert(shrink_to_fit());
+static_assert(assignment());
+static_assert(expand_in_place());
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// Checks the capacity allocators report, and that a vector makes use of it.
+
+#include <cstddef>
+#include <cstdio>
+
+#include "constexpr_containers/allocator.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr bool
+size_classes()
+{
+  return cec::size_class_bytes(0) == 16 and cec::size_class_bytes(17) == 32 and
+         cec::size_class_bytes(4095) == 4096 and cec::size_class_bytes(4096) == 4096 and
+         cec::size_class_bytes(4097) == 8192 and cec::size_class_bytes(100, 64) == 128;
+}
+
+// malloc_allocator hands out exactly what was asked for, even nothing
+constexpr bool
+malloc_allocator()
+{
+  auto alloc = cec::malloc_allocator<int>();
+  for (std::size_t n : { 0, 1, 5, 1000 }) {
+    auto [p, count] = cec::allocate_at_least(alloc, n);
+    if (p == nullptr or count != n) {
+      return false;
+    }
+    alloc.deallocate(p, count);
+  }
+  return true;
+}
+
+constexpr bool
+size_class_allocator()
+{
+  auto alloc = cec::size_class_allocator<int>();
+  auto [small, small_count] = cec::allocate_at_least(alloc, 5);
+  auto [large, large_count] = cec::allocate_at_least(alloc, 1025);
+  if (small_count != 8 or large_count != 2048) {
+    return false;
+  }
+  // Any count between the one asked for and the one returned frees the same block
+  alloc.deallocate(small, 6);
+  alloc.deallocate(large, large_count);
+
+  // A vector uses the whole block
+  auto v = cec::vector<int, cec::size_class_allocator<int>>();
+  v.push_back(1);
+  v.resize(9);
+  return v.capacity() == 16;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "size_classes", size_classes },
+  { "malloc_allocator", malloc_allocator },
+  { "size_class_allocator", size_class_allocator },
+};
+
+static_assert(size_classes());
+static_assert(malloc_allocator());
+static_assert(size_class_allocator());
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,3 @@
+// This file is only used to give iwyu a chance to fix header files
+#include "constexpr_containers/arena.h"
+int main() {}
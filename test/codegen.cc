@@ -0,0 +1,61 @@
+// Loops which should optimize the same whichever vector they run over.
+// Never run, only compiled by test/codegen.py with -DVECTOR=<vector template>.
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+using ints = VECTOR<int>;
+
+int
+range_for_sum(const ints& v)
+{
+  int sum = 0;
+  for (const auto& x : v) {
+    sum += x;
+  }
+  return sum;
+}
+
+int
+index_sum(const ints& v)
+{
+  int sum = 0;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    sum += v[i];
+  }
+  return sum;
+}
+
+int
+accumulate(const ints& v)
+{
+  return std::accumulate(v.begin(), v.end(), 0);
+}
+
+void
+scale(ints& v, int factor)
+{
+  for (auto& x : v) {
+    x *= factor;
+  }
+}
+
+void
+zip_transform_add(ints& dst, const ints& a, const ints& b)
+{
+  cec::zip_transform(
+    a.begin(), a.end(), dst.begin(), [](int x, int y) { return x + y; }, b.begin());
+}
+
+void
+zip_foreach_add(ints& a, const ints& b)
+{
+  cec::zip_foreach(
+    a.begin(), a.end(), [](int& x, int y) { x += y; }, b.begin());
+}
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Codegen check: loops over cec::vector must vectorize wherever they do over std::vector.
+
+Compiles test/codegen.cc once per vector template and optimization level, asks the compiler
+which loops it vectorized (-fopt-info-vec-optimized for GCC, -Rpass=loop-vectorize for Clang),
+and fails if any loop vectorized for std::vector isn't vectorized for the other vectors.
+It also fails if nothing vectorized for std::vector, as the comparison would then prove nothing.
+
+At -O2, GCC 12 only vectorizes loops which need neither an epilogue nor a runtime alias check
+(-fvect-cost-model=very-cheap), which none of these loops qualify for, so the -O2 build is
+compiled with -fvect-cost-model=dynamic: everything else about -O2 stays, but the vectorizer
+gets to see the loops.
+
+Compilers which aren't installed are skipped.
+"""
+
+import collections
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+REFERENCE = "std::vector"
+VECTORS = ["constexpr_containers::vector", "constexpr_containers::pmr::vector"]
+LEVELS = ["-O2", "-O3"]
+
+# The flag asking for vectorization remarks, the regex picking out the loop location, and extra
+# flags per level
+COMPILERS = {
+    "g++": (
+        ["-fopt-info-vec-optimized"],
+        re.compile(r"^(\S+:\d+:\d+): optimized: loop vectorized"),
+        {"-O2": ["-fvect-cost-model=dynamic"]},
+    ),
+    "clang++": (
+        ["-Rpass=loop-vectorize"],
+        re.compile(r"^(\S+:\d+:\d+): remark: vectorized loop"),
+        {},
+    ),
+}
+
+
+def vectorized_loops(compiler, flags, pattern, level_args, vector):
+    cmd = [
+        compiler,
+        "-std=c++20",
+        *level_args,
+        *flags,
+        "-I",
+        os.path.join(ROOT, "include"),
+        f"-DVECTOR={vector}",
+        "-c",
+        os.path.join(ROOT, "test", "codegen.cc"),
+        "-o",
+        os.devnull,
+    ]
+    proc = subprocess.run(cmd, capture_output=True, text=True, cwd=ROOT)
+    if proc.returncode != 0:
+        sys.stderr.write(proc.stderr)
+        raise SystemExit(f"{compiler} {' '.join(level_args)} -DVECTOR={vector}: failed to compile")
+    matches = (pattern.match(line) for line in proc.stderr.splitlines())
+    return collections.Counter(m.group(1) for m in matches if m)
+
+
+def main():
+    failures = 0
+    for compiler, (flags, pattern, level_flags) in COMPILERS.items():
+        if shutil.which(compiler) is None:
+            print(f"{compiler}: not found, skipping")
+            continue
+        for level in LEVELS:
+            level_args = [level, *level_flags.get(level, [])]
+            expected = vectorized_loops(compiler, flags, pattern, level_args, REFERENCE)
+            print(
+                f"{compiler} {' '.join(level_args)}: "
+                f"{sum(expected.values())} loops vectorized for {REFERENCE}"
+            )
+            if not expected:
+                print("  FAILED: nothing to compare against")
+                failures += 1
+            for vector in VECTORS:
+                missing = expected - vectorized_loops(compiler, flags, pattern, level_args, vector)
+                for location in sorted(missing):
+                    print(f"  FAILED: {vector} doesn't vectorize {location}")
+                failures += len(missing)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,61 @@
+// Checks that bulk inserts into a flat_map keep using the containers' allocators.
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <utility>
+
+#include "constexpr_containers/arena.h"
+#include "constexpr_containers/flat_map.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+template<typename T>
+using arena_vector = cec::vector<T, cec::arena_allocator<T>>;
+
+using arena_map = cec::flat_map<int, int, std::less<int>, arena_vector<int>, arena_vector<int>>;
+
+// arena_allocator has no default constructor, so this wouldn't even compile if the merged
+// containers were default constructed
+bool
+stateful_allocator()
+{
+  alignas(std::max_align_t) std::byte buffer[4096];
+  auto scratch = cec::arena(buffer);
+  auto m =
+    arena_map(arena_vector<int>({ 5, 1, 3 }, scratch), arena_vector<int>({ 50, 10, 30 }, scratch));
+  // Inserted out of order, so they have to be merged into the existing elements
+  const std::pair<int, int> more[] = { { 4, 40 }, { 2, 20 }, { 1, 0 } };
+  m.insert(std::begin(more), std::end(more));
+  return m.size() == 5 and m.at(1) == 10 and m.at(4) == 40 and
+         &m.keys().get_allocator().resource() == &scratch and
+         &m.values().get_allocator().resource() == &scratch;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "stateful_allocator", stateful_allocator },
+};
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
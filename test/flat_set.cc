@@ -0,0 +1,59 @@
+// Checks that bulk inserts into a flat_set keep using the container's allocator.
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "constexpr_containers/arena.h"
+#include "constexpr_containers/flat_set.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+using arena_vector = cec::vector<int, cec::arena_allocator<int>>;
+using arena_set = cec::flat_set<int, std::less<int>, arena_vector>;
+
+// arena_allocator has no default constructor, so this wouldn't even compile if the merged
+// container was default constructed
+bool
+stateful_allocator()
+{
+  alignas(std::max_align_t) std::byte buffer[4096];
+  auto scratch = cec::arena(buffer);
+  auto s = arena_set(arena_vector({ 5, 1, 3 }, scratch));
+  // Inserted out of order, so they have to be merged into the existing elements
+  const int more[] = { 4, 2, 1 };
+  s.insert(std::begin(more), std::end(more));
+  auto keys = std::move(s).extract();
+  return keys == arena_vector({ 1, 2, 3, 4, 5 }, scratch) and
+         &keys.get_allocator().resource() == &scratch;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "stateful_allocator", stateful_allocator },
+};
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -1,8 +1,18 @@
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <iterator>
+#include <string>
+#include <utility>
 
 #include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/eytzinger.h"
+#include "constexpr_containers/flat_map.h"
+#include "constexpr_containers/flat_set.h"
+#include "constexpr_containers/freeze.h"
+#include "constexpr_containers/perfect_hash.h"
+#include "constexpr_containers/small_vector.h"
+#include "constexpr_containers/static_vector.h"
 #include "constexpr_containers/vector.h"
 
 constexpr auto f()
@@ -31,10 +41,117 @@ constexpr auto h()
   return 1;
 }
 
+constexpr auto s()
+{
+  constexpr_containers::small_vector<int, 2> v{ 1, 2 };
+  v.push_back(3);
+  auto v2 = std::move(v);
+  return v2.back();
+}
+
+// std::string needs laundering, so its iterators are launder_iterators
+constexpr auto strings()
+{
+  constexpr_containers::vector<std::string> v{ "b", "c" };
+  v.insert(v.begin(), "a");
+  v.erase(v.end() - 1);
+  return v.rbegin()->size() + v.size();
+}
+
+// Compared with memcmp or simd::mismatch_bytes at runtime
+constexpr auto compare()
+{
+  constexpr_containers::vector<int> a{ 1, 2, 3 };
+  constexpr_containers::vector<int> b{ 1, 2, 4 };
+  return int(a < b) + int(a != b) + int(a == a);
+}
+
+// Both erase_if and unordered_erase_if call the predicate once per element
+constexpr auto erasing()
+{
+  constexpr_containers::vector<int> v{ 1, 2, 3, 4, 5, 6, 7 };
+  int calls = 0;
+  auto odd = [&](int x) {
+    ++calls;
+    return x % 2 == 1;
+  };
+  auto erased = v.unordered_erase_if(odd) + erase_if(v, odd);
+  v.unordered_erase(v.begin());
+  return erased + v.size() + calls;
+}
+
+constexpr auto flat()
+{
+  constexpr_containers::flat_map<int, int> m{ { 3, 30 }, { 1, 10 }, { 2, 20 }, { 1, 11 } };
+  m[4] = 40;
+  m.erase(2);
+  constexpr_containers::flat_set<int> s(m.keys().begin(), m.keys().end());
+  s.insert({ 2, 0, 2 });
+  return m.at(1) + m.find(3)->second + int(s.size()) + int(s.contains(2));
+}
+
+constexpr auto indexes()
+{
+  constexpr_containers::vector<int> v;
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i * i);
+  }
+  constexpr_containers::eytzinger_index<int> e(v);
+  constexpr_containers::btree_index<int> b(v);
+  return e.lower_bound(50) + b.upper_bound(49) + int(e.contains(81) and not b.contains(80));
+}
+
+constexpr auto squares()
+{
+  constexpr_containers::static_vector<int, 8> v;
+  for (int i = 0; not v.full(); ++i) {
+    v.push_back(i * i);
+  }
+  return v;
+}
+
+// A vector built during constant evaluation, whose size isn't known up front
+constexpr auto primes()
+{
+  constexpr_containers::vector<int> v;
+  for (int i = 2; i < 30; ++i) {
+    if (std::none_of(v.begin(), v.end(), [&](int p) { return i % p == 0; })) {
+      v.push_back(i);
+    }
+  }
+  return v;
+}
+
 int main()
 {
   [[maybe_unused]] std::array<int, f()> a;
   [[maybe_unused]] std::array<int, h()> c;
+  [[maybe_unused]] std::array<int, s()> d;
+  [[maybe_unused]] std::array<int, strings()> e;
+  [[maybe_unused]] std::array<int, compare()> g;
+  static_assert(erasing() == 4 + 2 + 7 + 3);
+  static_assert(flat() == 10 + 30 + 5 + 1);
+  static_assert(indexes() == 8 + 8 + 1);
+  constexpr auto digits = constexpr_containers::make_perfect_hash_map<[] {
+    constexpr_containers::vector<std::pair<char, int>> v;
+    for (int i = 0; i < 10; ++i) {
+      v.emplace_back(char('0' + i), i);
+    }
+    return v;
+  }>();
+  static_assert(digits.at('7') == 7 and not digits.contains('a'));
+  if (compare() != 3) {
+    return 1;
+  }
+  constexpr auto sq = squares();
+  constexpr auto frozen = constexpr_containers::freeze<[] { return squares(); }>();
+  static_assert(frozen.size() == 8 and frozen.back() == sq.back());
+  constexpr auto frozen_primes = constexpr_containers::freeze<[] { return primes(); }>();
+  [[maybe_unused]] std::array<int, frozen_primes.size()> p;
+  static_assert(frozen_primes.size() == 10 and
+                std::ranges::equal(frozen_primes,
+                                   std::array{ 2, 3, 5, 7, 11, 13, 17, 19, 23, 29 }));
+  std::cout << sq.back() << '\n';
   std::cout << sizeof(constexpr_containers::vector<int>) << '\n';
   constexpr_containers::vector<int> v;
   for (auto&& elem : constexpr_containers::make_range(v.begin(), v.end())) {
@@ -0,0 +1,163 @@
+// Checks that the parallel zip algorithms give the same results as the sequential ones, however
+// the work is split up, and that exceptions and nested runs behave.
+
+#include <cstddef>
+#include <cstdio>
+#include <execution>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <string_view>
+
+#include "constexpr_containers/parallel.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+constexpr std::size_t sizes[] = { 0, 1, 7, 100, 4097, 100003 };
+
+cec::vector<int>
+iota(std::size_t n, int start)
+{
+  auto v = cec::vector<int>(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v[i] = start + int(i);
+  }
+  return v;
+}
+
+constexpr auto op = [](int a, int b) { return a * 3 - b; };
+
+// Both overloads against the sequential ones, with the results written in place
+template<typename Policy>
+bool
+matches_sequential(const Policy& policy, std::size_t n)
+{
+  auto a = iota(n, 1);
+  auto b = iota(n, -5);
+  auto expected = cec::vector<int>(n);
+  cec::zip_transform(a.begin(), a.end(), expected.begin(), op, b.begin());
+
+  auto out = cec::vector<int>(n, -1);
+  auto end = cec::zip_transform(policy, a.begin(), a.end(), out.begin(), op, b.begin());
+  if (end != out.end() or out != expected) {
+    return false;
+  }
+  cec::zip_foreach(policy, a.begin(), a.end(), [](int& x, int y) { x = op(x, y); }, b.begin());
+  return a == expected;
+}
+
+bool
+parallel_overloads()
+{
+  auto pool = cec::thread_pool(3);
+  for (auto n : sizes) {
+    for (std::size_t chunk_size : { 0, 1, 13, 4096 }) {
+      for (std::size_t threads : { 0, 1, 2, 4 }) {
+        if (not matches_sequential(cec::parallel{ threads, chunk_size, &pool }, n)) {
+          std::printf("n = %zu, chunk_size = %zu, threads = %zu\n", n, chunk_size, threads);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool
+execution_policies()
+{
+  for (auto n : sizes) {
+    if (not matches_sequential(std::execution::seq, n) or
+        not matches_sequential(std::execution::par, n) or
+        not matches_sequential(std::execution::par_unseq, n) or
+        not matches_sequential(std::execution::unseq, n)) {
+      std::printf("n = %zu\n", n);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Without random access there's nothing to split, so it runs sequentially
+bool
+sequential_fallback()
+{
+  auto pool = cec::thread_pool(3);
+  auto a = std::list<int>{ 1, 2, 3 };
+  auto out = cec::vector<int>();
+  cec::zip_transform(
+    cec::parallel{ 0, 1, &pool }, a.begin(), a.end(), std::back_inserter(out), op, a.begin());
+  return out == cec::vector<int>{ 2, 4, 6 };
+}
+
+bool
+exceptions()
+{
+  auto pool = cec::thread_pool(3);
+  auto a = iota(10000, 0);
+  auto out = cec::vector<int>(10000);
+  try {
+    cec::zip_transform(cec::parallel{ 0, 16, &pool }, a.begin(), a.end(), out.begin(), [](int x) {
+      if (x == 5000) {
+        throw std::runtime_error("5000");
+      }
+      return x;
+    });
+    return false;
+  } catch (const std::runtime_error& e) {
+    if (e.what() != std::string_view("5000")) {
+      return false;
+    }
+  }
+  // The pool is still usable afterwards
+  return matches_sequential(cec::parallel{ 0, 16, &pool }, 10000);
+}
+
+// A run started from inside a run on the same pool runs sequentially instead of deadlocking
+bool
+nested()
+{
+  auto pool = cec::thread_pool(3);
+  auto rows = cec::vector<cec::vector<int>>(64, iota(1000, 0));
+  cec::zip_foreach(cec::parallel{ 0, 1, &pool }, rows.begin(), rows.end(), [&](auto& row) {
+    cec::zip_foreach(cec::parallel{ 0, 10, &pool }, row.begin(), row.end(), [](int& x) { ++x; });
+  });
+  for (const auto& row : rows) {
+    if (row != iota(1000, 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "parallel_overloads", parallel_overloads },
+  { "execution_policies", execution_policies },
+  { "sequential_fallback", sequential_fallback },
+  { "exceptions", exceptions },
+  { "nested", nested },
+};
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+// Checks simd::remove_equal against std::erase, for every element type it vectorizes and for
+// sizes which leave scalar tails, and that erase(v, value) gives the same results whatever the
+// type of value.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "constexpr_containers/simd.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+// Up to a few whole vectors of every width, plus tails of every length, and a big one
+constexpr std::size_t sizes[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 100, 1001 };
+
+// A mix of the value to remove, in runs and alone, and a few others
+template<typename T>
+std::vector<T>
+elements(std::size_t n, T value, unsigned seed)
+{
+  auto v = std::vector<T>(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    seed = seed * 1103515245 + 12345;
+    auto r = (seed >> 16) % 8;
+    v[i] = r < 3 ? value : T(r);
+  }
+  return v;
+}
+
+template<typename T>
+bool
+remove_equal(T value)
+{
+  for (auto n : sizes) {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+      auto expected = elements(n, value, seed);
+      auto v = expected;
+      std::erase(expected, value);
+      auto kept = cec::simd::remove_equal(v.data(), v.size(), value);
+      v.resize(kept);
+      if (v != expected) {
+        std::printf("n = %zu, seed = %u\n", n, seed);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool
+remove_equal_integers()
+{
+  return remove_equal(std::int32_t(5)) and remove_equal(std::uint32_t(0)) and
+         remove_equal(std::int64_t(-1)) and
+         remove_equal(std::numeric_limits<std::uint64_t>::max()) and
+         remove_equal(std::int32_t(42));
+}
+
+bool
+remove_equal_floating_point()
+{
+  if (not remove_equal(0.0f) or not remove_equal(3.0) or not remove_equal(-0.0)) {
+    return false;
+  }
+  // -0.0 == 0.0, and nothing equals NaN
+  auto v = std::vector<double>{ 0.0, -0.0, 1.0, std::numeric_limits<double>::quiet_NaN() };
+  if (cec::simd::remove_equal(v.data(), v.size(), 0.0) != 2 or v[0] != 1.0) {
+    return false;
+  }
+  auto nan = std::numeric_limits<float>::quiet_NaN();
+  auto w = std::vector<float>{ nan, 1.0f, nan, 2.0f, nan, 3.0f, nan, 4.0f, nan };
+  return cec::simd::remove_equal(w.data(), w.size(), nan) == w.size();
+}
+
+// erase(v, value) against std::erase with the same value, which may not have the element type
+template<typename T, typename U>
+bool
+erase(U value)
+{
+  for (auto n : sizes) {
+    auto expected = elements(n, T(value), 1);
+    auto v = cec::vector<T>(expected.begin(), expected.end());
+    auto erased = std::erase(expected, value);
+    if (cec::erase(v, value) != erased or not std::ranges::equal(v, expected)) {
+      std::printf("n = %zu\n", n);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+erase_converted_value()
+{
+  return erase<std::uint32_t>(0) and erase<std::uint32_t>(-1) and erase<std::int64_t>(7u) and
+         erase<std::int32_t>(std::int64_t(1) << 33) and erase<float>(0.0) and erase<float>(0.1) and
+         erase<double>(2) and erase<double>(2.5f) and erase<std::int32_t>(2.0) and
+         erase<std::int32_t>(2.5);
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "remove_equal_integers", remove_equal_integers },
+  { "remove_equal_floating_point", remove_equal_floating_point },
+  { "erase_converted_value", erase_converted_value },
+};
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+// Checks static_vector's modifiers, both for trivially copyable elements (during constant
+// evaluation too) and for elements which are kept in raw bytes, and what each overflow policy does.
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "constexpr_containers/static_vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+template<typename V, typename T>
+constexpr bool
+same(const V& v, std::initializer_list<T> expected)
+{
+  return std::equal(v.begin(), v.end(), expected.begin(), expected.end());
+}
+
+constexpr bool
+modifiers()
+{
+  auto v = cec::static_vector<int, 16>{ 1, 2, 3 };
+  v.insert(v.begin() + 1, 9);
+  v.emplace(v.begin(), 8);
+  v.insert(v.end() - 1, 2, 7);
+  if (not same(v, { 8, 1, 9, 2, 7, 7, 3 })) {
+    return false;
+  }
+  // Inserting copies of an element of the vector
+  v.insert(v.begin(), 3, v[6]);
+  auto more = std::vector<int>{ 4, 5 };
+  v.insert_range(v.begin() + 3, more);
+  v.append_range(more);
+  if (not same(v, { 3, 3, 3, 4, 5, 8, 1, 9, 2, 7, 7, 3, 4, 5 })) {
+    return false;
+  }
+  v.erase(v.begin(), v.begin() + 3);
+  v.erase(v.begin() + 2);
+  if (cec::erase(v, 7) != 2 or not same(v, { 4, 5, 1, 9, 2, 3, 4, 5 })) {
+    return false;
+  }
+  if (cec::erase_if(v, [](int x) { return x > 4; }) != 3 or not same(v, { 4, 1, 2, 3, 4 })) {
+    return false;
+  }
+  v.unordered_erase(v.begin());
+  if (v.unordered_erase_if([](int x) { return x == 1; }) != 1 or not same(v, { 4, 3, 2 })) {
+    return false;
+  }
+  v = { 1, 2 };
+  v.resize(4, 6);
+  auto w = v;
+  w.pop_back();
+  return same(v, { 1, 2, 6, 6 }) and w < v and w != v and v.size() == 4;
+}
+
+// An element with a destructor, which counts how many are alive
+struct tracked
+{
+  static inline int live = 0;
+  std::string value;
+
+  tracked(const char* s)
+    : value(s)
+  {
+    ++live;
+  }
+  tracked(const tracked& other)
+    : value(other.value)
+  {
+    ++live;
+  }
+  tracked(tracked&& other) noexcept
+    : value(std::move(other.value))
+  {
+    ++live;
+  }
+  tracked& operator=(const tracked&) = default;
+  tracked& operator=(tracked&&) noexcept = default;
+  ~tracked() { --live; }
+
+  bool operator==(const tracked&) const = default;
+  auto operator<=>(const tracked&) const = default;
+};
+
+using strings = cec::static_vector<tracked, 8>;
+
+bool
+strings_equal(const strings& v, std::initializer_list<const char*> expected)
+{
+  return std::equal(v.begin(), v.end(), expected.begin(), expected.end(), [](auto& a, auto b) {
+    return a.value == b;
+  });
+}
+
+bool
+non_trivial()
+{
+  {
+    auto v = strings{ "a", "b", "c" };
+    v.insert(v.begin() + 1, v[2]);
+    v.insert(v.begin(), 2, tracked("x"));
+    v.erase(v.begin() + 1);
+    if (not strings_equal(v, { "x", "a", "c", "b", "c" })) {
+      return false;
+    }
+    auto copy = v;
+    v.erase_if([](const tracked& t) { return t.value == "c"; });
+    copy = v;
+    auto moved = std::move(v);
+    v = { "p", "q", "r", "s", "t", "u" };
+    swap(v, moved);
+    if (not strings_equal(copy, { "x", "a", "b" }) or not strings_equal(v, { "x", "a", "b" }) or
+        moved.size() != 6 or not(copy == v) or not(moved < copy)) {
+      return false;
+    }
+    moved.unordered_erase_if([](const tracked& t) { return t.value < "s"; });
+    if (not strings_equal(moved, { "u", "t", "s" }) or tracked::live != 9) {
+      return false;
+    }
+  }
+  return tracked::live == 0;
+}
+
+bool
+throw_exception()
+{
+  auto v = cec::static_vector<int, 2>{ 1, 2 };
+  try {
+    v.push_back(3);
+    return false;
+  } catch (const std::length_error&) {
+  }
+  try {
+    v.insert(v.begin(), 2, 0);
+    return false;
+  } catch (const std::length_error&) {
+  }
+  // Nothing happened
+  return v.size() == 2 and v[0] == 1 and v[1] == 2;
+}
+
+bool
+abort_policy()
+{
+  auto pid = fork();
+  if (pid == 0) {
+    auto v = cec::static_vector<int, 2, cec::overflow::abort>{ 1, 2 };
+    v.push_back(3);
+    _exit(0);
+  }
+  auto status = 0;
+  waitpid(pid, &status, 0);
+  return WIFSIGNALED(status) and WTERMSIG(status) == SIGABRT;
+}
+
+bool
+unchecked()
+{
+  // Only checks that nothing is checked within the capacity
+  static_assert(not cec::overflow::unchecked::checked);
+  auto v = cec::static_vector<int, 2, cec::overflow::unchecked>();
+  v.reserve(2);
+  v.push_back(1);
+  v.push_back(2);
+  return v.full();
+}
+
+// Trivially copyable, but with a default constructor which counts how often it runs at runtime
+struct counted
+{
+  static inline int constructions = 0;
+  int value = 7;
+
+  constexpr counted()
+  {
+    if (not std::is_constant_evaluated()) {
+      ++constructions;
+    }
+  }
+};
+
+constexpr bool
+default_member_initializers()
+{
+  auto v = cec::static_vector<counted, 64>();
+  v.emplace_back();
+  v.resize(3);
+  return v.size() == 3 and v[2].value == 7;
+}
+
+// Only the elements which are actually there get constructed
+bool
+no_constructions_up_front()
+{
+  auto v = cec::static_vector<counted, 1024>();
+  if (counted::constructions != 0) {
+    return false;
+  }
+  v.emplace_back();
+  return counted::constructions == 1 and default_member_initializers();
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "modifiers", modifiers },
+  { "non_trivial", non_trivial },
+  { "throw_exception", throw_exception },
+  { "abort", abort_policy },
+  { "unchecked", unchecked },
+  { "no_constructions_up_front", no_constructions_up_front },
+};
+
+static_assert(modifiers());
+static_assert(default_member_initializers());
+static_assert(std::is_trivially_copyable_v<cec::static_vector<counted, 4>>);
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// Checks that stats::counting counts what vector_base's buffers do, and that stats::none is free.
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "constexpr_containers/arena.h"
+#include "constexpr_containers/growth_policy.h"
+#include "constexpr_containers/stats_counting.h"
+#include "constexpr_containers/stats_policy.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+struct growing
+{
+  static constexpr const char* name = "growing";
+};
+
+struct expanding
+{
+  static constexpr const char* name = "expanding";
+};
+
+static_assert(sizeof(cec::vector<int>) == 3 * sizeof(int*));
+
+bool
+counting()
+{
+  using stats = cec::stats::counting<growing>;
+  {
+    auto v = cec::vector<int, std::allocator<int>, cec::growth::doubling, stats>();
+    for (int i = 0; i < 100; ++i) {
+      v.push_back(i);
+    }
+    // Buffers of 1, 2, 4, ..., 128 elements, every one but the last relocated when full
+    const auto& c = stats::get();
+    if (c.allocations != 8 or c.deallocations != 7 or c.reallocations != 7 or
+        c.relocated_elements != 127 or c.relocated_bytes != 127 * sizeof(int) or
+        c.peak_capacity != 128 or c.expansions != 0) {
+      return false;
+    }
+  }
+  // The last buffer was freed with 28 elements never used
+  const auto& c = stats::get();
+  return c.deallocations == 8 and c.slack_elements == 28 and c.slack_bytes == 28 * sizeof(int);
+}
+
+bool
+expansions()
+{
+  using stats = cec::stats::counting<expanding>;
+  alignas(std::max_align_t) std::byte buffer[4096];
+  auto scratch = cec::arena(buffer);
+  {
+    auto v = cec::vector<int, cec::arena_allocator<int>, cec::growth::doubling, stats>(scratch);
+    for (int i = 0; i < 100; ++i) {
+      v.push_back(i);
+    }
+    // The first buffer is the last thing in the arena, so it grows in place every time
+    const auto& c = stats::get();
+    if (c.allocations != 1 or c.expansions != 7 or c.reallocations != 0 or
+        c.peak_capacity != 128) {
+      return false;
+    }
+  }
+  return stats::get().deallocations == 1;
+}
+
+bool
+registry()
+{
+  auto seen = 0;
+  for (const auto& entry : cec::stats::registry()) {
+    if (std::strcmp(entry.name, growing::name) == 0) {
+      seen += entry.stats == &cec::stats::counting<growing>::get();
+    }
+    if (std::strcmp(entry.name, expanding::name) == 0) {
+      seen += entry.stats == &cec::stats::counting<expanding>::get();
+    }
+  }
+  return seen == 2;
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+// registry relies on the others having used their tags
+constexpr test tests[] = {
+  { "counting", counting },
+  { "expansions", expansions },
+  { "registry", registry },
+};
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -1,3 +1,134 @@
-// This file is only used to give iwyu a chance to fix header files
+// Checks what erase_if and unordered_erase_if leave behind when the predicate throws.
+
+#include <algorithm>
+#include <cstdio>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+
 #include "constexpr_containers/vector.h"
-int main() {}
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+// Erases erase, throws on throw_on, keeps everything else
+struct pred
+{
+  int erase;
+  int throw_on;
+
+  bool operator()(int x) const
+  {
+    if (x == throw_on) {
+      throw std::runtime_error("pred");
+    }
+    return x == erase;
+  }
+};
+
+template<typename Fn>
+bool
+throws(Fn fn)
+{
+  try {
+    fn();
+  } catch (const std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+// Compares ignoring the order, for unordered_erase_if
+bool
+same_elements(cec::vector<int> v, std::initializer_list<int> expected)
+{
+  std::ranges::sort(v);
+  return std::ranges::equal(v, expected);
+}
+
+bool
+erase_if_throwing()
+{
+  auto v = cec::vector<int>{ 1, 2, 3, 4 };
+  if (not throws([&] { v.erase_if(pred{ 1, 3 }); })) {
+    return false;
+  }
+  return v == cec::vector<int>{ 2, 3, 4 };
+}
+
+// pred throws while looking for an element to erase
+bool
+unordered_erase_if_throwing_forward()
+{
+  auto v = cec::vector<int>{ 1, 2, 3, 4, 5 };
+  if (not throws([&] { v.unordered_erase_if(pred{ 1, 3 }); })) {
+    return false;
+  }
+  return same_elements(v, { 2, 3, 4, 5 });
+}
+
+// pred throws while looking for a survivor at the back to replace an erased element with
+bool
+unordered_erase_if_throwing_backward()
+{
+  auto v = cec::vector<int>{ 1, 2, 3, 4 };
+  if (not throws([&] { v.unordered_erase_if(pred{ 1, 4 }); })) {
+    return false;
+  }
+  if (not same_elements(v, { 2, 3, 4 })) {
+    return false;
+  }
+  // Elements the backward scan had already erased stay erased
+  v = { 1, 2, 3, 4, 1 };
+  if (not throws([&] { v.unordered_erase_if(pred{ 1, 4 }); })) {
+    return false;
+  }
+  return same_elements(v, { 2, 3, 4 });
+}
+
+// Nothing is leaked or destroyed twice (the sanitizers check that)
+bool
+unordered_erase_if_throwing_strings()
+{
+  auto v = cec::vector<std::string>{ "erase", "keep", "throw", "erase" };
+  auto throwing = [](const std::string& s) {
+    if (s == "throw") {
+      throw std::runtime_error(s);
+    }
+    return s == "erase";
+  };
+  if (not throws([&] { v.unordered_erase_if(throwing); })) {
+    return false;
+  }
+  std::ranges::sort(v);
+  return v == cec::vector<std::string>{ "keep", "throw" };
+}
+
+struct test
+{
+  const char* name;
+  bool (*fn)();
+};
+
+constexpr test tests[] = {
+  { "erase_if_throwing", erase_if_throwing },
+  { "unordered_erase_if_throwing_forward", unordered_erase_if_throwing_forward },
+  { "unordered_erase_if_throwing_backward", unordered_erase_if_throwing_backward },
+  { "unordered_erase_if_throwing_strings", unordered_erase_if_throwing_strings },
+};
+
+} // namespace
+
+int
+main()
+{
+  int failures = 0;
+  for (const auto& t : tests) {
+    if (not t.fn()) {
+      std::printf("FAILED: %s\n", t.name);
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}